@@ -13,6 +13,7 @@
 #include "Debugger/ITraceLogger.h"
 #include "Debugger/ExpressionEvaluator.h"
 #include "Debugger/TraceLogFileSaver.h"
+#include "Debugger/TraceStore.h"
 #include "Utilities/HexUtilities.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
@@ -117,6 +118,23 @@ struct TraceLogPpuState
 	uint32_t FrameCount;
 };
 
+//Effective address and memory value, captured on the emulation thread for rows that are formatted later
+struct TraceLogEffectiveAddress
+{
+	EffectiveAddressInfo Info;
+	uint32_t Value;
+};
+
+//Binary row sent to the trace log file saver
+template<typename CpuStateType>
+struct TraceLogRecord
+{
+	CpuStateType CpuState;
+	DisassemblyInfo Disassembly;
+	TraceLogPpuState PpuState;
+	TraceLogEffectiveAddress EffectiveAddress;
+};
+
 struct RowPart
 {
 	RowDataType DataType;
@@ -142,6 +160,7 @@ protected:
 	MemoryType _cpuMemoryType = MemoryType::SnesMemory;
 
 	vector<RowPart> _rowParts;
+	bool _needEffectiveAddress = false;
 
 	uint32_t _currentPos = 0;
 
@@ -186,9 +205,9 @@ protected:
 		}
 	}
 	
-	void WriteEffectiveAddress(DisassemblyInfo& info, RowPart& rowPart, void* cpuState, string& output, MemoryType cpuMemoryType, CpuType cpuType)
+	void WriteEffectiveAddress(DisassemblyInfo& info, RowPart& rowPart, void* cpuState, string& output, MemoryType cpuMemoryType, CpuType cpuType, TraceLogEffectiveAddress* capturedAddress)
 	{
-		EffectiveAddressInfo effectiveAddress = info.GetEffectiveAddress(_debugger, cpuState, cpuType);
+		EffectiveAddressInfo effectiveAddress = capturedAddress ? capturedAddress->Info : info.GetEffectiveAddress(_debugger, cpuState, cpuType);
 		if(effectiveAddress.ShowAddress && effectiveAddress.Address >= 0) {
 			MemoryType effectiveMemType = effectiveAddress.Type == MemoryType::None ? cpuMemoryType : effectiveAddress.Type;
 			if(_options.UseLabels) {
@@ -209,12 +228,12 @@ protected:
 		}
 	}
 
-	void WriteMemoryValue(DisassemblyInfo& info, RowPart& rowPart, void* cpuState, string& output, MemoryType memType, CpuType cpuType)
+	void WriteMemoryValue(DisassemblyInfo& info, RowPart& rowPart, void* cpuState, string& output, MemoryType memType, CpuType cpuType, TraceLogEffectiveAddress* capturedAddress)
 	{
-		EffectiveAddressInfo effectiveAddress = info.GetEffectiveAddress(_debugger, cpuState, cpuType);
+		EffectiveAddressInfo effectiveAddress = capturedAddress ? capturedAddress->Info : info.GetEffectiveAddress(_debugger, cpuState, cpuType);
 		if(effectiveAddress.Address >= 0 && effectiveAddress.ValueSize > 0) {
 			MemoryType effectiveMemType = effectiveAddress.Type == MemoryType::None ? memType : effectiveAddress.Type;
-			uint16_t value = info.GetMemoryValue(effectiveAddress, _memoryDumper, effectiveMemType);
+			uint16_t value = capturedAddress ? capturedAddress->Value : info.GetMemoryValue(effectiveAddress, _memoryDumper, effectiveMemType);
 			if(rowPart.DisplayInHex) {
 				output += "= $";
 				if(effectiveAddress.ValueSize == 2) {
@@ -286,19 +305,43 @@ protected:
 
 		_pendingLog = false;
 
-		if(_debugger->GetTraceLogFileSaver()->IsEnabled()) {
-			string row;
-			row.reserve(300);
-			
-			//Display PC
-			RowPart rowPart = {};
-			rowPart.DisplayInHex = true;
-			rowPart.MinWidth = DebugUtilities::GetProgramCounterSize(_cpuType);
-			WriteIntValue(row, ((TraceLoggerType*)this)->GetProgramCounter(cpuState), rowPart);
-			row += "  ";
-
-			((TraceLoggerType*)this)->GetTraceRow(row, cpuState, _ppuState[_currentPos], disassemblyInfo);
-			_debugger->GetTraceLogFileSaver()->Log(row);
+		TraceLogFileSaver* fileSaver = _debugger->GetTraceLogFileSaver();
+		TraceStore* traceStore = _debugger->GetTraceStore();
+		if(fileSaver->IsEnabled() || traceStore->IsEnabled()) {
+			//Only copy the row's data here, the text is generated later (see FormatRecord/GetRecordTraceRow)
+			TraceLogEffectiveAddress effectiveAddress = {};
+			if(_needEffectiveAddress || traceStore->IsEnabled()) {
+				//Depends on the current emulation state, so it can't be calculated later
+				effectiveAddress.Info = disassemblyInfo.GetEffectiveAddress(_debugger, &cpuState, _cpuType);
+				if(effectiveAddress.Info.Address >= 0 && effectiveAddress.Info.ValueSize > 0) {
+					MemoryType effectiveMemType = effectiveAddress.Info.Type == MemoryType::None ? _cpuMemoryType : effectiveAddress.Info.Type;
+					effectiveAddress.Value = disassemblyInfo.GetMemoryValue(effectiveAddress.Info, _memoryDumper, effectiveMemType);
+				}
+			}
+
+			TraceLogPpuState& ppuState = _ppuState[_currentPos];
+			if(fileSaver->IsEnabled()) {
+				void* buffer = fileSaver->BeginRecord(_cpuType, sizeof(TraceLogRecord<CpuStateType>));
+				new(buffer) TraceLogRecord<CpuStateType> { cpuState, disassemblyInfo, ppuState, effectiveAddress };
+				fileSaver->EndRecord();
+			}
+
+			if(traceStore->IsEnabled()) {
+				//The store's search filters need the effective address, even if the format doesn't display it
+				TraceStoreRowHeader header = {
+					((TraceLoggerType*)this)->GetProgramCounter(cpuState),
+					(int32_t)effectiveAddress.Info.Address,
+					ppuState.FrameCount,
+					ppuState.Scanline,
+					_cpuType
+				};
+
+				void* buffer = traceStore->BeginRow(header);
+				if(buffer) {
+					new(buffer) TraceLogRecord<CpuStateType> { cpuState, disassemblyInfo, ppuState, effectiveAddress };
+					traceStore->EndRow();
+				}
+			}
 		}
 
 		_currentPos = (_currentPos + 1) % ExecutionLogSize;
@@ -307,6 +350,7 @@ protected:
 	void ParseFormatString(string format)
 	{
 		_rowParts.clear();
+		_needEffectiveAddress = false;
 
 		std::regex formatRegex = std::regex("(\\[\\s*([^[]*?)\\s*(,\\s*([\\d]*)\\s*(h){0,1}){0,1}\\s*\\])|([^[]*)", std::regex_constants::icase);
 		std::sregex_iterator start = std::sregex_iterator(format.cbegin(), format.cend(), formatRegex);
@@ -337,6 +381,7 @@ protected:
 				}
 				part.DisplayInHex = match.str(5) == "h";
 
+				_needEffectiveAddress |= part.DataType == RowDataType::EffectiveAddress || part.DataType == RowDataType::MemoryValue;
 				_rowParts.push_back(part);
 			}
 		}
@@ -373,14 +418,14 @@ protected:
 
 	virtual RowDataType GetFormatTagType(string& tag) = 0;
 
-	void ProcessSharedTag(RowPart& rowPart, string& output, CpuStateType& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo)
+	void ProcessSharedTag(RowPart& rowPart, string& output, CpuStateType& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 	{
 		switch(rowPart.DataType) {
 			case RowDataType::Text: output += rowPart.Text; break;
 			case RowDataType::ByteCode: WriteByteCode(disassemblyInfo, rowPart, output); break;
 			case RowDataType::Disassembly: WriteDisassembly(disassemblyInfo, rowPart, ((TraceLoggerType*)this)->GetStackPointer(cpuState), ((TraceLoggerType*)this)->GetProgramCounter(cpuState), output); break;
-			case RowDataType::EffectiveAddress: WriteEffectiveAddress(disassemblyInfo, rowPart, &cpuState, output, _cpuMemoryType, _cpuType); break;
-			case RowDataType::MemoryValue: WriteMemoryValue(disassemblyInfo, rowPart, &cpuState, output, _cpuMemoryType, _cpuType); break;
+			case RowDataType::EffectiveAddress: WriteEffectiveAddress(disassemblyInfo, rowPart, &cpuState, output, _cpuMemoryType, _cpuType, capturedAddress); break;
+			case RowDataType::MemoryValue: WriteMemoryValue(disassemblyInfo, rowPart, &cpuState, output, _cpuMemoryType, _cpuType, capturedAddress); break;
 			case RowDataType::Align: WriteAlign(0, rowPart, output); break;
 
 			case RowDataType::Cycle: WriteIntValue(output, ppuState.Cycle, rowPart); break;
@@ -468,8 +513,12 @@ public:
 	void SetOptions(TraceLoggerOptions options) override
 	{
 		DebugBreakHelper helper(_debugger);
-		_options = options;
 
+		//Rows that were already logged are formatted with the format they were logged with - flush them before
+		//changing the options, the file saver's thread reads them while formatting
+		_debugger->GetTraceLogFileSaver()->Flush();
+
+		_options = options;
 		_enabled = options.Enabled;
 
 		string condition = _options.Condition;
@@ -510,19 +559,53 @@ public:
 		return true;
 	}
 
+	uint32_t GetRecordSize() override
+	{
+		return sizeof(TraceLogRecord<CpuStateType>);
+	}
+
+	void FormatRecord(uint8_t* data, string& output) override
+	{
+		TraceLogRecord<CpuStateType>& record = *(TraceLogRecord<CpuStateType>*)data;
+
+		//Align tags are relative to the start of the row, so each row is generated separately
+		string row;
+		row.reserve(300);
+
+		//Display PC
+		RowPart rowPart = {};
+		rowPart.DisplayInHex = true;
+		rowPart.MinWidth = DebugUtilities::GetProgramCounterSize(_cpuType);
+		WriteIntValue(row, ((TraceLoggerType*)this)->GetProgramCounter(record.CpuState), rowPart);
+		row += "  ";
+
+		((TraceLoggerType*)this)->GetTraceRow(row, record.CpuState, record.PpuState, record.Disassembly, _needEffectiveAddress ? &record.EffectiveAddress : nullptr);
+		output += row;
+		output += '\n';
+	}
+
+	void GetRecordTraceRow(uint8_t* data, TraceRow& row) override
+	{
+		TraceLogRecord<CpuStateType>& record = *(TraceLogRecord<CpuStateType>*)data;
+		FillTraceRow(row, record.CpuState, record.PpuState, record.Disassembly, _needEffectiveAddress ? &record.EffectiveAddress : nullptr);
+	}
+
 	void GetExecutionTrace(TraceRow& row, uint32_t offset) override
 	{
 		int pos = ((int)_currentPos - offset);
 		int index = (pos > 0 ? pos : BaseTraceLogger::ExecutionLogSize + pos) - 1;
+		FillTraceRow(row, _cpuState[index], _ppuState[index], _disassemblyCache[index], nullptr);
+	}
 
-		CpuStateType& state = _cpuState[index];
+	void FillTraceRow(TraceRow& row, CpuStateType& state, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
+	{
 		string logOutput;
 		logOutput.reserve(300);
-		((TraceLoggerType*)this)->GetTraceRow(logOutput, state, _ppuState[index], _disassemblyCache[index]);
+		((TraceLoggerType*)this)->GetTraceRow(logOutput, state, ppuState, disassemblyInfo, capturedAddress);
 
 		row.Type = _cpuType;
-		_disassemblyCache[index].GetByteCode(row.ByteCode);
-		row.ByteCodeSize = _disassemblyCache[index].GetOpSize();
+		disassemblyInfo.GetByteCode(row.ByteCode);
+		row.ByteCodeSize = disassemblyInfo.GetOpSize();
 		row.ProgramCounter = ((TraceLoggerType*)this)->GetProgramCounter(state);
 		row.LogSize = std::min<uint32_t>(499, (uint32_t)logOutput.size());
 		memcpy(row.LogOutput, logOutput.c_str(), row.LogSize);
@@ -3,28 +3,6 @@
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
 
-template<uint8_t accessWidth>
-bool Breakpoint::Matches(MemoryOperationInfo& operation, AddressInfo &info)
-{
-	if(operation.MemType == _memoryType && DebugUtilities::IsRelativeMemory(_memoryType)) {
-		for(int i = 0; i < accessWidth; i++) {
-			if((int32_t)operation.Address + i >= _startAddr && (int32_t)operation.Address + i <= _endAddr) {
-				return true;
-			}
-		}
-		return false;
-	} else if(_memoryType == info.Type) {
-		for(int i = 0; i < accessWidth; i++) {
-			if(info.Address + i >= _startAddr && info.Address + i <= _endAddr) {
-				return true;
-			}
-		}
-		return false;
-	}
-
-	return false;
-}
-
 bool Breakpoint::HasBreakpointType(BreakpointType type)
 {
 	switch(type) {
@@ -55,6 +33,21 @@ CpuType Breakpoint::GetCpuType()
 	return _cpuType;
 }
 
+MemoryType Breakpoint::GetMemoryType()
+{
+	return _memoryType;
+}
+
+int32_t Breakpoint::GetStartAddress()
+{
+	return _startAddr;
+}
+
+int32_t Breakpoint::GetEndAddress()
+{
+	return _endAddr;
+}
+
 bool Breakpoint::IsEnabled()
 {
 	return _enabled;
@@ -72,7 +65,3 @@ bool Breakpoint::IsAllowedForOpType(MemoryOperationType opType)
 	}
 	return true;
 }
-
-template bool Breakpoint::Matches<1>(MemoryOperationInfo& operation, AddressInfo& info);
-template bool Breakpoint::Matches<2>(MemoryOperationInfo& operation, AddressInfo& info);
-template bool Breakpoint::Matches<4>(MemoryOperationInfo& operation, AddressInfo& info);
@@ -12,13 +12,15 @@ struct MemoryOperationInfo;
 class Breakpoint
 {
 public:
-	template<uint8_t accessWidth = 1> bool Matches(MemoryOperationInfo &opInfo, AddressInfo &info);
 	bool HasBreakpointType(BreakpointType type);
 	string GetCondition();
 	bool HasCondition();
 
 	uint32_t GetId();
 	CpuType GetCpuType();
+	MemoryType GetMemoryType();
+	int32_t GetStartAddress();
+	int32_t GetEndAddress();
 	bool IsEnabled();
 	bool IsMarked();
 	bool IsAllowedForOpType(MemoryOperationType opType);
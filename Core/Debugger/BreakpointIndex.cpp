@@ -0,0 +1,70 @@
+#include "pch.h"
+#include <algorithm>
+#include "Debugger/BreakpointIndex.h"
+
+void BreakpointIndex::Build(vector<BreakpointRange>& ranges)
+{
+	_segments.clear();
+	_breakpoints.clear();
+	_pages.clear();
+	_minAddress = 0;
+	_maxAddress = -1;
+
+	//Every range start/end is a segment boundary
+	vector<int64_t> bounds;
+	for(BreakpointRange& range : ranges) {
+		if(range.End >= range.Start) {
+			bounds.push_back(range.Start);
+			bounds.push_back((int64_t)range.End + 1);
+		}
+	}
+
+	if(bounds.empty()) {
+		return;
+	}
+
+	std::sort(bounds.begin(), bounds.end());
+	bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+	for(size_t i = 0; i + 1 < bounds.size(); i++) {
+		Segment segment = { (int32_t)bounds[i], (int32_t)(bounds[i + 1] - 1), (uint32_t)_breakpoints.size(), 0 };
+		for(BreakpointRange& range : ranges) {
+			if(range.Start <= segment.Start && range.End >= segment.End) {
+				_breakpoints.push_back(range.BreakpointIndex);
+				segment.Count++;
+			}
+		}
+
+		if(segment.Count > 0) {
+			//Gaps between ranges don't need a segment
+			_segments.push_back(segment);
+		}
+	}
+
+	_minAddress = _segments.front().Start;
+	_maxAddress = _segments.back().End;
+
+	uint64_t pageCount = (((int64_t)_maxAddress - _minAddress) >> PageShift) + 1;
+	if(pageCount <= MaxPageCount) {
+		_pages.resize((size_t)((pageCount + 63) / 64));
+		for(Segment& segment : _segments) {
+			uint64_t firstPage = ((int64_t)segment.Start - _minAddress) >> PageShift;
+			uint64_t lastPage = ((int64_t)segment.End - _minAddress) >> PageShift;
+			for(uint64_t page = firstPage; page <= lastPage; page++) {
+				_pages[page >> 6] |= (uint64_t)1 << (page & 0x3F);
+			}
+		}
+	}
+}
+
+void BreakpointIndex::InternalGetMatches(int32_t start, int32_t end, vector<uint32_t>& matches)
+{
+	//Find the first segment that ends at or after the start address
+	auto itr = std::lower_bound(_segments.begin(), _segments.end(), start, [](const Segment& segment, int32_t address) {
+		return segment.End < address;
+	});
+
+	for(; itr != _segments.end() && itr->Start <= end; itr++) {
+		matches.insert(matches.end(), _breakpoints.begin() + itr->First, _breakpoints.begin() + itr->First + itr->Count);
+	}
+}
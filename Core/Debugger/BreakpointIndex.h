@@ -0,0 +1,64 @@
+#pragma once
+#include "pch.h"
+
+struct BreakpointRange
+{
+	int32_t Start;
+	int32_t End;
+	uint32_t BreakpointIndex;
+};
+
+//Address lookup table for the breakpoints of a single memory type/operation type.
+//The breakpoint ranges are split into sorted, non-overlapping segments that each list the breakpoints covering them.
+//A bitmap of the pages that contain at least one breakpoint lets most accesses be rejected with a single lookup.
+class BreakpointIndex
+{
+private:
+	static constexpr int PageShift = 10;
+	static constexpr uint64_t MaxPageCount = 0x40000;
+
+	struct Segment
+	{
+		int32_t Start;
+		int32_t End;
+		uint32_t First;
+		uint32_t Count;
+	};
+
+	vector<Segment> _segments;
+	vector<uint32_t> _breakpoints;
+	vector<uint64_t> _pages;
+	int32_t _minAddress = 0;
+	int32_t _maxAddress = -1;
+
+	__forceinline bool IsPageUsed(int32_t address)
+	{
+		if(_pages.empty()) {
+			//Range is too large for the bitmap
+			return true;
+		}
+		uint32_t page = (uint32_t)(address - _minAddress) >> PageShift;
+		return (_pages[page >> 6] >> (page & 0x3F)) & 0x01;
+	}
+
+	void InternalGetMatches(int32_t start, int32_t end, vector<uint32_t>& matches);
+
+public:
+	void Build(vector<BreakpointRange>& ranges);
+
+	//Appends the index of every breakpoint overlapping [address, address + accessWidth - 1] to matches, in ascending order
+	template<uint8_t accessWidth>
+	__forceinline void GetMatches(int32_t address, vector<uint32_t>& matches)
+	{
+		int32_t end = address + (accessWidth - 1);
+		if(end < _minAddress || address > _maxAddress) {
+			return;
+		}
+
+		if(!IsPageUsed(std::max(address, _minAddress)) && (accessWidth == 1 || !IsPageUsed(std::min(end, _maxAddress)))) {
+			return;
+		}
+
+		InternalGetMatches(address, end, matches);
+	}
+};
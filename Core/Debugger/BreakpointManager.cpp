@@ -25,6 +25,9 @@ void BreakpointManager::SetBreakpoints(Breakpoint breakpoints[], uint32_t count)
 		_breakpoints[i].clear();
 		_rpnList[i].clear();
 		_hasBreakpointType[i] = false;
+		for(int j = 0; j < DebugUtilities::GetMemoryTypeCount(); j++) {
+			_index[i][j].reset();
+		}
 	}
 
 	_bpExpEval.reset(new ExpressionEvaluator(_debugger, _cpuDebugger, _cpuType));
@@ -41,14 +44,14 @@ void BreakpointManager::SetBreakpoints(Breakpoint breakpoints[], uint32_t count)
 
 				if(bp.IsAllowedForOpType(opType)) {
 					_breakpoints[i].push_back(bp);
-				}
 
-				if(bp.HasCondition()) {
-					bool success = true;
-					ExpressionData data = _bpExpEval->GetRpnList(bp.GetCondition(), success);
-					_rpnList[i].push_back(success ? data : ExpressionData());
-				} else {
-					_rpnList[i].push_back(ExpressionData());
+					if(bp.HasCondition()) {
+						bool success = true;
+						ExpressionData data = _bpExpEval->GetRpnList(bp.GetCondition(), success);
+						_rpnList[i].push_back(success ? data : ExpressionData());
+					} else {
+						_rpnList[i].push_back(ExpressionData());
+					}
 				}
 				
 				_hasBreakpoint = true;
@@ -56,6 +59,26 @@ void BreakpointManager::SetBreakpoints(Breakpoint breakpoints[], uint32_t count)
 			}
 		}
 	}
+
+	BuildIndex();
+}
+
+void BreakpointManager::BuildIndex()
+{
+	for(int i = 0; i < BreakpointManager::BreakpointTypeCount; i++) {
+		vector<BreakpointRange> ranges[DebugUtilities::GetMemoryTypeCount()];
+		for(uint32_t j = 0; j < (uint32_t)_breakpoints[i].size(); j++) {
+			Breakpoint& bp = _breakpoints[i][j];
+			ranges[(int)bp.GetMemoryType()].push_back({ bp.GetStartAddress(), bp.GetEndAddress(), j });
+		}
+
+		for(int j = 0; j < DebugUtilities::GetMemoryTypeCount(); j++) {
+			if(!ranges[j].empty()) {
+				_index[i][j].reset(new BreakpointIndex());
+				_index[i][j]->Build(ranges[j]);
+			}
+		}
+	}
 }
 
 BreakpointType BreakpointManager::GetBreakpointType(MemoryOperationType type)
@@ -84,20 +107,43 @@ BreakpointType BreakpointManager::GetBreakpointType(MemoryOperationType type)
 template<uint8_t accessWidth>
 int BreakpointManager::InternalCheckBreakpoint(MemoryOperationInfo operationInfo, AddressInfo &address, bool processMarkedBreakpoints)
 {
+	int opType = (int)operationInfo.Type;
+	_matches.clear();
+
+	//Same rules as Breakpoint::Matches: breakpoints on a cpu memory type are checked against the cpu address,
+	//all others are checked against the absolute address
+	bool isRelative = DebugUtilities::IsRelativeMemory(operationInfo.MemType);
+	if(isRelative && _index[opType][(int)operationInfo.MemType]) {
+		_index[opType][(int)operationInfo.MemType]->GetMatches<accessWidth>((int32_t)operationInfo.Address, _matches);
+	}
+
+	size_t relMatchCount = _matches.size();
+	if((address.Type != operationInfo.MemType || !isRelative) && _index[opType][(int)address.Type]) {
+		_index[opType][(int)address.Type]->GetMatches<accessWidth>(address.Address, _matches);
+	}
+
+	if(_matches.empty()) {
+		return -1;
+	}
+
+	if((relMatchCount > 0 && _matches.size() > relMatchCount) || accessWidth > 1) {
+		//Process the breakpoints in the same order as they were set
+		std::sort(_matches.begin(), _matches.end());
+		_matches.erase(std::unique(_matches.begin(), _matches.end()), _matches.end());
+	}
+
 	EvalResultType resultType;
-	vector<Breakpoint> &breakpoints = _breakpoints[(int)operationInfo.Type];
-	for(size_t i = 0, len = breakpoints.size(); i < len; i++) {
-		if(breakpoints[i].Matches<accessWidth>(operationInfo, address)) {
-			if(breakpoints[i].HasCondition() && !_bpExpEval->Evaluate(_rpnList[(int)operationInfo.Type][i], resultType, operationInfo, address)) {
-				continue;
-			}
+	vector<Breakpoint> &breakpoints = _breakpoints[opType];
+	for(uint32_t i : _matches) {
+		if(breakpoints[i].HasCondition() && !_bpExpEval->Evaluate(_rpnList[opType][i], resultType, operationInfo, address)) {
+			continue;
+		}
 
-			if(breakpoints[i].IsMarked() && processMarkedBreakpoints) {
-				_eventManager->AddEvent(DebugEventType::Breakpoint, operationInfo, breakpoints[i].GetId());
-			}
-			if(breakpoints[i].IsEnabled()) {
-				return breakpoints[i].GetId();
-			}
+		if(breakpoints[i].IsMarked() && processMarkedBreakpoints) {
+			_eventManager->AddEvent(DebugEventType::Breakpoint, operationInfo, breakpoints[i].GetId());
+		}
+		if(breakpoints[i].IsEnabled()) {
+			return breakpoints[i].GetId();
 		}
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include "Debugger/Breakpoint.h"
+#include "Debugger/BreakpointIndex.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
 
@@ -26,9 +27,14 @@ private:
 	bool _hasBreakpoint;
 	bool _hasBreakpointType[BreakpointTypeCount] = {};
 
+	//Address index for each operation type + memory type (null when there are no breakpoints for that combination)
+	unique_ptr<BreakpointIndex> _index[BreakpointTypeCount][DebugUtilities::GetMemoryTypeCount()];
+	vector<uint32_t> _matches;
+
 	unique_ptr<ExpressionEvaluator> _bpExpEval;
 
 	BreakpointType GetBreakpointType(MemoryOperationType type);
+	void BuildIndex();
 	template<uint8_t accessWidth> int InternalCheckBreakpoint(MemoryOperationInfo operationInfo, AddressInfo &address, bool processMarkedBreakpoints);
 
 public:
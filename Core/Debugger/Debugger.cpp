@@ -17,6 +17,7 @@
 #include "Debugger/ExpressionEvaluator.h"
 #include "Debugger/BaseEventManager.h"
 #include "Debugger/TraceLogFileSaver.h"
+#include "Debugger/TraceStore.h"
 #include "Debugger/CdlManager.h"
 #include "Debugger/ITraceLogger.h"
 #include "SNES/SnesCpuTypes.h"
@@ -75,7 +76,8 @@ Debugger::Debugger(Emulator* emu, IConsole* console)
 	_disassemblySearch.reset(new DisassemblySearch(_disassembler.get(), _labelManager.get()));
 	_memoryAccessCounter.reset(new MemoryAccessCounter(this));
 	_scriptManager.reset(new ScriptManager(this));
-	_traceLogSaver.reset(new TraceLogFileSaver());
+	_traceLogSaver.reset(new TraceLogFileSaver(this));
+	_traceStore.reset(new TraceStore(this));
 	_cdlManager.reset(new CdlManager(this, _disassembler.get()));
 
 	//Use cpuTypes for iteration (ordered), not _cpuTypes (order is important for coprocessors, etc.)
@@ -35,6 +35,7 @@ class IAssembler;
 class IDebugger;
 class ITraceLogger;
 class TraceLogFileSaver;
+class TraceStore;
 class FrozenAddressManager;
 
 struct TraceRow;
@@ -74,6 +75,7 @@ private:
 	unique_ptr<CdlManager> _cdlManager;
 
 	unique_ptr<TraceLogFileSaver> _traceLogSaver;
+	unique_ptr<TraceStore> _traceStore;
 
 	SimpleLock _logLock;
 	std::list<string> _debuggerLog;
@@ -180,6 +182,7 @@ public:
 	CpuType GetMainCpuType() { return _mainCpuType; }
 
 	TraceLogFileSaver* GetTraceLogFileSaver() { return _traceLogSaver.get(); }
+	TraceStore* GetTraceStore() { return _traceStore.get(); }
 	MemoryDumper* GetMemoryDumper() { return _memoryDumper.get(); }
 	MemoryAccessCounter* GetMemoryAccessCounter() { return _memoryAccessCounter.get(); }
 	Disassembler* GetDisassembler() { return _disassembler.get(); }
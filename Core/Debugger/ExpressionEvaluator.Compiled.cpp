@@ -0,0 +1,359 @@
+#include "pch.h"
+#include "Debugger/ExpressionEvaluator.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/IDebugger.h"
+#include "Debugger/MemoryDumper.h"
+#include "Debugger/LabelManager.h"
+#include "Shared/MemoryOperationType.h"
+
+//Intermediate tree built from the RPN queue, used to fold constants before generating the program
+struct ExpressionNode
+{
+	ExpressionOpCode OpCode;
+	int64_t Value;
+	int32_t Left;
+	int32_t Right;
+	EvalResultType ResultType;
+	bool ResultFromToken;
+};
+
+static bool IsBinaryOpCode(ExpressionOpCode opCode)
+{
+	return opCode >= ExpressionOpCode::Multiplication;
+}
+
+static ExpressionOpCode GetOpCode(EvalOperators op)
+{
+	switch(op) {
+		case EvalOperators::Multiplication: return ExpressionOpCode::Multiplication;
+		case EvalOperators::Division: return ExpressionOpCode::Division;
+		case EvalOperators::Modulo: return ExpressionOpCode::Modulo;
+		case EvalOperators::Addition: return ExpressionOpCode::Addition;
+		case EvalOperators::Substration: return ExpressionOpCode::Substration;
+		case EvalOperators::ShiftLeft: return ExpressionOpCode::ShiftLeft;
+		case EvalOperators::ShiftRight: return ExpressionOpCode::ShiftRight;
+		case EvalOperators::SmallerThan: return ExpressionOpCode::SmallerThan;
+		case EvalOperators::SmallerOrEqual: return ExpressionOpCode::SmallerOrEqual;
+		case EvalOperators::GreaterThan: return ExpressionOpCode::GreaterThan;
+		case EvalOperators::GreaterOrEqual: return ExpressionOpCode::GreaterOrEqual;
+		case EvalOperators::Equal: return ExpressionOpCode::Equal;
+		case EvalOperators::NotEqual: return ExpressionOpCode::NotEqual;
+		case EvalOperators::BinaryAnd: return ExpressionOpCode::BinaryAnd;
+		case EvalOperators::BinaryXor: return ExpressionOpCode::BinaryXor;
+		case EvalOperators::BinaryOr: return ExpressionOpCode::BinaryOr;
+		case EvalOperators::LogicalAnd: return ExpressionOpCode::LogicalAnd;
+		case EvalOperators::LogicalOr: return ExpressionOpCode::LogicalOr;
+		case EvalOperators::Minus: return ExpressionOpCode::Minus;
+		case EvalOperators::BinaryNot: return ExpressionOpCode::BinaryNot;
+		case EvalOperators::LogicalNot: return ExpressionOpCode::LogicalNot;
+		case EvalOperators::AbsoluteAddress: return ExpressionOpCode::AbsoluteAddress;
+		case EvalOperators::ReadDword: return ExpressionOpCode::ReadDword;
+		case EvalOperators::Bracket: return ExpressionOpCode::ReadByte;
+		case EvalOperators::Braces: return ExpressionOpCode::ReadWord;
+		default: throw std::runtime_error("Invalid operator");
+	}
+}
+
+static EvalResultType GetResultType(ExpressionOpCode opCode)
+{
+	switch(opCode) {
+		case ExpressionOpCode::SmallerThan:
+		case ExpressionOpCode::SmallerOrEqual:
+		case ExpressionOpCode::GreaterThan:
+		case ExpressionOpCode::GreaterOrEqual:
+		case ExpressionOpCode::Equal:
+		case ExpressionOpCode::NotEqual:
+		case ExpressionOpCode::LogicalAnd:
+		case ExpressionOpCode::LogicalOr:
+			return EvalResultType::Boolean;
+
+		default:
+			return EvalResultType::Numeric;
+	}
+}
+
+static bool FoldConstant(ExpressionOpCode opCode, int64_t left, int64_t right, int64_t& result)
+{
+	switch(opCode) {
+		case ExpressionOpCode::Multiplication: result = left * right; return true;
+		case ExpressionOpCode::Division: if(right == 0) { return false; } result = left / right; return true;
+		case ExpressionOpCode::Modulo: if(right == 0) { return false; } result = left % right; return true;
+		case ExpressionOpCode::Addition: result = left + right; return true;
+		case ExpressionOpCode::Substration: result = left - right; return true;
+		case ExpressionOpCode::ShiftLeft: result = left << right; return true;
+		case ExpressionOpCode::ShiftRight: result = left >> right; return true;
+		case ExpressionOpCode::SmallerThan: result = left < right; return true;
+		case ExpressionOpCode::SmallerOrEqual: result = left <= right; return true;
+		case ExpressionOpCode::GreaterThan: result = left > right; return true;
+		case ExpressionOpCode::GreaterOrEqual: result = left >= right; return true;
+		case ExpressionOpCode::Equal: result = left == right; return true;
+		case ExpressionOpCode::NotEqual: result = left != right; return true;
+		case ExpressionOpCode::BinaryAnd: result = left & right; return true;
+		case ExpressionOpCode::BinaryXor: result = left ^ right; return true;
+		case ExpressionOpCode::BinaryOr: result = left | right; return true;
+		case ExpressionOpCode::LogicalAnd: result = (bool)(left && right); return true;
+		case ExpressionOpCode::LogicalOr: result = (bool)(left || right); return true;
+		case ExpressionOpCode::Minus: result = -right; return true;
+		case ExpressionOpCode::BinaryNot: result = ~right; return true;
+		case ExpressionOpCode::LogicalNot: result = (bool)!right; return true;
+
+		default:
+			//Memory reads/address conversions depend on the emulation state
+			return false;
+	}
+}
+
+static bool CanFail(vector<ExpressionNode>& nodes, int32_t index)
+{
+	if(index < 0) {
+		return false;
+	}
+
+	ExpressionNode& node = nodes[index];
+	switch(node.OpCode) {
+		case ExpressionOpCode::Label:
+			return true;
+
+		case ExpressionOpCode::Division:
+		case ExpressionOpCode::Modulo:
+			if(nodes[node.Right].OpCode != ExpressionOpCode::Constant || nodes[node.Right].Value == 0) {
+				return true;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return CanFail(nodes, node.Left) || CanFail(nodes, node.Right);
+}
+
+static void Emit(vector<ExpressionNode>& nodes, int32_t index, vector<ExpressionInstruction>& code)
+{
+	ExpressionNode& node = nodes[index];
+	ExpressionInstruction instr = { node.OpCode, false, 0, node.Value };
+
+	if(!IsBinaryOpCode(node.OpCode)) {
+		if(node.Right >= 0) {
+			Emit(nodes, node.Right, code);
+			instr.Value = 0;
+		}
+		code.push_back(instr);
+		return;
+	}
+
+	Emit(nodes, node.Left, code);
+
+	ExpressionNode& right = nodes[node.Right];
+	bool isLogical = node.OpCode == ExpressionOpCode::LogicalAnd || node.OpCode == ExpressionOpCode::LogicalOr;
+	if(isLogical && right.OpCode != ExpressionOpCode::Constant && !CanFail(nodes, node.Right)) {
+		//The interpreter always evaluates both operands - the right operand can only be skipped when it can't produce an error
+		size_t skipIndex = code.size();
+		code.push_back({ node.OpCode == ExpressionOpCode::LogicalAnd ? ExpressionOpCode::SkipIfFalse : ExpressionOpCode::SkipIfTrue, false, 0, 0 });
+		Emit(nodes, node.Right, code);
+		code.push_back(instr);
+		code[skipIndex].Jump = (uint16_t)code.size();
+	} else if(right.OpCode == ExpressionOpCode::Constant) {
+		instr.ConstantOperand = true;
+		instr.Value = right.Value;
+		code.push_back(instr);
+	} else {
+		Emit(nodes, node.Right, code);
+		instr.Value = 0;
+		code.push_back(instr);
+	}
+}
+
+shared_ptr<CompiledExpression> ExpressionEvaluator::Compile(ExpressionData& data)
+{
+	vector<ExpressionNode> nodes;
+	vector<int32_t> stack;
+
+	for(int64_t token : data.RpnQueue) {
+		ExpressionNode node = { ExpressionOpCode::Constant, token, -1, -1, EvalResultType::Numeric, false };
+
+		if(token >= EvalValues::RegA) {
+			if(token >= EvalValues::FirstLabelIndex) {
+				//Labels can be moved/deleted, so they are resolved every time the expression is evaluated
+				node.OpCode = ExpressionOpCode::Label;
+				node.Value = token - EvalValues::FirstLabelIndex;
+			} else {
+				switch(token) {
+					case EvalValues::Value: node.OpCode = ExpressionOpCode::Value; break;
+					case EvalValues::Address: node.OpCode = ExpressionOpCode::Address; break;
+					case EvalValues::MemoryAddress: node.OpCode = ExpressionOpCode::MemoryAddress; break;
+					case EvalValues::IsWrite: node.OpCode = ExpressionOpCode::IsWrite; break;
+					case EvalValues::IsRead: node.OpCode = ExpressionOpCode::IsRead; break;
+					case EvalValues::IsDma: node.OpCode = ExpressionOpCode::IsDma; break;
+					case EvalValues::IsDummy: node.OpCode = ExpressionOpCode::IsDummy; break;
+					case EvalValues::OpProgramCounter: node.OpCode = ExpressionOpCode::OpProgramCounter; break;
+
+					default:
+						if(_cpuDebugger && _getTokenValue) {
+							node.OpCode = ExpressionOpCode::CpuToken;
+							node.ResultFromToken = true;
+						} else {
+							node.Value = 0;
+						}
+						break;
+				}
+			}
+		} else if(token >= EvalOperators::Multiplication) {
+			EvalOperators op = (EvalOperators)token;
+			if(op > EvalOperators::Braces) {
+				return nullptr;
+			}
+
+			bool isBinary = op <= EvalOperators::LogicalOr;
+			if(stack.size() < (isBinary ? 2u : 1u)) {
+				//Let the interpreter handle malformed expressions
+				return nullptr;
+			}
+
+			node.Right = stack.back();
+			stack.pop_back();
+			if(isBinary) {
+				node.Left = stack.back();
+				stack.pop_back();
+			}
+
+			if(op == EvalOperators::Plus) {
+				//Unary plus doesn't generate any code, but its result is always numeric
+				node = nodes[node.Right];
+				node.ResultType = EvalResultType::Numeric;
+				node.ResultFromToken = false;
+			} else {
+				node.OpCode = GetOpCode(op);
+				node.Value = 0;
+				node.ResultType = GetResultType(node.OpCode);
+			}
+
+			int64_t result;
+			bool isConstant = nodes[node.Right].OpCode == ExpressionOpCode::Constant && (!isBinary || nodes[node.Left].OpCode == ExpressionOpCode::Constant);
+			if(op != EvalOperators::Plus && isConstant && FoldConstant(node.OpCode, isBinary ? nodes[node.Left].Value : 0, nodes[node.Right].Value, result)) {
+				//Children stay in the list, but are no longer referenced
+				node = { ExpressionOpCode::Constant, result, -1, -1, node.ResultType, false };
+			}
+		}
+
+		nodes.push_back(node);
+		stack.push_back((int32_t)nodes.size() - 1);
+
+		if(stack.size() >= 100) {
+			return nullptr;
+		}
+	}
+
+	if(stack.size() != 1) {
+		return nullptr;
+	}
+
+	shared_ptr<CompiledExpression> expr(new CompiledExpression());
+	ExpressionNode& root = nodes[stack.back()];
+	expr->ResultType = root.ResultType;
+	expr->ResultFromToken = root.ResultFromToken;
+	Emit(nodes, stack.back(), expr->Code);
+	return expr;
+}
+
+int64_t ExpressionEvaluator::EvaluateCompiled(ExpressionData& data, EvalResultType& resultType, MemoryOperationInfo& operationInfo, AddressInfo& addressInfo)
+{
+	CompiledExpression& expr = *data.Compiled;
+	ExpressionInstruction* code = expr.Code.data();
+	size_t codeSize = expr.Code.size();
+
+	EvalResultType tokenType = EvalResultType::Numeric;
+	int64_t stack[100];
+	int pos = -1;
+
+	for(size_t i = 0; i < codeSize; i++) {
+		ExpressionInstruction& instr = code[i];
+		switch(instr.OpCode) {
+			case ExpressionOpCode::Constant: stack[++pos] = instr.Value; break;
+			case ExpressionOpCode::Value: stack[++pos] = operationInfo.Value; break;
+			case ExpressionOpCode::Address: stack[++pos] = operationInfo.Address; break;
+			case ExpressionOpCode::MemoryAddress: stack[++pos] = addressInfo.Address; break;
+			case ExpressionOpCode::IsWrite: stack[++pos] = operationInfo.Type == MemoryOperationType::Write || operationInfo.Type == MemoryOperationType::DmaWrite || operationInfo.Type == MemoryOperationType::DummyWrite; break;
+			case ExpressionOpCode::IsRead: stack[++pos] = operationInfo.Type != MemoryOperationType::Write && operationInfo.Type != MemoryOperationType::DmaWrite && operationInfo.Type != MemoryOperationType::DummyWrite; break;
+			case ExpressionOpCode::IsDma: stack[++pos] = operationInfo.Type == MemoryOperationType::DmaRead || operationInfo.Type == MemoryOperationType::DmaWrite; break;
+			case ExpressionOpCode::IsDummy: stack[++pos] = operationInfo.Type == MemoryOperationType::DummyRead || operationInfo.Type == MemoryOperationType::DummyWrite; break;
+			case ExpressionOpCode::OpProgramCounter: stack[++pos] = _cpuDebugger->GetProgramCounter(true); break;
+			case ExpressionOpCode::CpuToken: stack[++pos] = (this->*_getTokenValue)(instr.Value, tokenType); break;
+
+			case ExpressionOpCode::Label: {
+				int64_t address = (size_t)instr.Value < data.Labels.size() ? _labelManager->GetLabelRelativeAddress(data.Labels[(uint32_t)instr.Value], _cpuType) : -2;
+				if(address < 0) {
+					resultType = address == -1 ? EvalResultType::OutOfScope : EvalResultType::Invalid;
+					return 0;
+				}
+				stack[++pos] = address;
+				break;
+			}
+
+			case ExpressionOpCode::Minus: stack[pos] = -stack[pos]; break;
+			case ExpressionOpCode::BinaryNot: stack[pos] = ~stack[pos]; break;
+			case ExpressionOpCode::LogicalNot: stack[pos] = !stack[pos]; break;
+			case ExpressionOpCode::AbsoluteAddress: stack[pos] = stack[pos] >= 0 ? _debugger->GetAbsoluteAddress({ (int32_t)stack[pos], _cpuMemory }).Address : -1; break;
+			case ExpressionOpCode::ReadByte: stack[pos] = _debugger->GetMemoryDumper()->GetMemoryValue(_cpuMemory, (uint32_t)stack[pos]); break;
+			case ExpressionOpCode::ReadWord: stack[pos] = _debugger->GetMemoryDumper()->GetMemoryValue16(_cpuMemory, (uint32_t)stack[pos]); break;
+			case ExpressionOpCode::ReadDword: stack[pos] = _debugger->GetMemoryDumper()->GetMemoryValue32(_cpuMemory, (uint32_t)stack[pos]); break;
+
+			case ExpressionOpCode::SkipIfFalse:
+				if(!stack[pos]) {
+					stack[pos] = 0;
+					i = instr.Jump - 1;
+				}
+				break;
+
+			case ExpressionOpCode::SkipIfTrue:
+				if(stack[pos]) {
+					stack[pos] = 1;
+					i = instr.Jump - 1;
+				}
+				break;
+
+			default: {
+				int64_t right = instr.ConstantOperand ? instr.Value : stack[pos--];
+				int64_t& left = stack[pos];
+				switch(instr.OpCode) {
+					case ExpressionOpCode::Multiplication: left *= right; break;
+					case ExpressionOpCode::Division:
+						if(right == 0) {
+							resultType = EvalResultType::DivideBy0;
+							return 0;
+						}
+						left /= right;
+						break;
+					case ExpressionOpCode::Modulo:
+						if(right == 0) {
+							resultType = EvalResultType::DivideBy0;
+							return 0;
+						}
+						left %= right;
+						break;
+					case ExpressionOpCode::Addition: left += right; break;
+					case ExpressionOpCode::Substration: left -= right; break;
+					case ExpressionOpCode::ShiftLeft: left <<= right; break;
+					case ExpressionOpCode::ShiftRight: left >>= right; break;
+					case ExpressionOpCode::SmallerThan: left = left < right; break;
+					case ExpressionOpCode::SmallerOrEqual: left = left <= right; break;
+					case ExpressionOpCode::GreaterThan: left = left > right; break;
+					case ExpressionOpCode::GreaterOrEqual: left = left >= right; break;
+					case ExpressionOpCode::Equal: left = left == right; break;
+					case ExpressionOpCode::NotEqual: left = left != right; break;
+					case ExpressionOpCode::BinaryAnd: left &= right; break;
+					case ExpressionOpCode::BinaryXor: left ^= right; break;
+					case ExpressionOpCode::BinaryOr: left |= right; break;
+					case ExpressionOpCode::LogicalAnd: left = left && right; break;
+					case ExpressionOpCode::LogicalOr: left = left || right; break;
+					default: break;
+				}
+				break;
+			}
+		}
+	}
+
+	//The type of a single token depends on the token (e.g flags are booleans)
+	resultType = expr.ResultFromToken ? tokenType : expr.ResultType;
+	return std::clamp<int64_t>(stack[0], INT32_MIN, UINT32_MAX);
+}
@@ -363,6 +363,10 @@ int64_t ExpressionEvaluator::Evaluate(ExpressionData &data, EvalResultType &resu
 		return 0;
 	}
 
+	if(data.Compiled) {
+		return EvaluateCompiled(data, resultType, operationInfo, addressInfo);
+	}
+
 	int pos = 0;
 	int64_t right = 0;
 	int64_t left = 0;
@@ -491,6 +495,20 @@ ExpressionEvaluator::ExpressionEvaluator(Debugger* debugger, IDebugger* cpuDebug
 	_labelManager = debugger->GetLabelManager();
 	_cpuType = cpuType;
 	_cpuMemory = DebugUtilities::GetCpuMemoryType(cpuType);
+
+	switch(_cpuType) {
+		case CpuType::Snes: _getTokenValue = &ExpressionEvaluator::GetSnesTokenValue; break;
+		case CpuType::Spc: _getTokenValue = &ExpressionEvaluator::GetSpcTokenValue; break;
+		case CpuType::NecDsp: _getTokenValue = &ExpressionEvaluator::GetNecDspTokenValue; break;
+		case CpuType::Sa1: _getTokenValue = &ExpressionEvaluator::GetSnesTokenValue; break;
+		case CpuType::Gsu: _getTokenValue = &ExpressionEvaluator::GetGsuTokenValue; break;
+		case CpuType::Cx4: _getTokenValue = &ExpressionEvaluator::GetCx4TokenValue; break;
+		case CpuType::Gameboy: _getTokenValue = &ExpressionEvaluator::GetGameboyTokenValue; break;
+		case CpuType::Nes: _getTokenValue = &ExpressionEvaluator::GetNesTokenValue; break;
+		case CpuType::Pce: _getTokenValue = &ExpressionEvaluator::GetPceTokenValue; break;
+		case CpuType::Sms: _getTokenValue = &ExpressionEvaluator::GetSmsTokenValue; break;
+		case CpuType::Gba: _getTokenValue = &ExpressionEvaluator::GetGbaTokenValue; break;
+	}
 }
 
 bool ExpressionEvaluator::ReturnBool(int64_t value, EvalResultType& resultType)
@@ -557,6 +575,8 @@ ExpressionData* ExpressionEvaluator::PrivateGetRpnList(string expression, bool&
 		ExpressionData data;
 		success = ToRpn(fixedExp, data);
 		if(success) {
+			data.Compiled = Compile(data);
+
 			LockHandler lock = _cacheLock.AcquireSafe();
 			_cache[expression] = data;
 			cachedData = &_cache[expression];
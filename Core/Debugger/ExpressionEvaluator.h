@@ -199,10 +199,77 @@ public:
 	}
 };
 
+enum class ExpressionOpCode : uint8_t
+{
+	//Push a value on the stack
+	Constant,
+	Value,
+	Address,
+	MemoryAddress,
+	IsWrite,
+	IsRead,
+	IsDma,
+	IsDummy,
+	OpProgramCounter,
+	CpuToken,
+	Label,
+
+	//Unary operators, applied to the top of the stack
+	Minus,
+	BinaryNot,
+	LogicalNot,
+	AbsoluteAddress,
+	ReadByte,
+	ReadWord,
+	ReadDword,
+
+	//Skip the right operand of && and || when the left operand already determines the result
+	SkipIfFalse,
+	SkipIfTrue,
+
+	//Binary operators, the right operand is either a constant or the top of the stack
+	Multiplication,
+	Division,
+	Modulo,
+	Addition,
+	Substration,
+	ShiftLeft,
+	ShiftRight,
+	SmallerThan,
+	SmallerOrEqual,
+	GreaterThan,
+	GreaterOrEqual,
+	Equal,
+	NotEqual,
+	BinaryAnd,
+	BinaryXor,
+	BinaryOr,
+	LogicalAnd,
+	LogicalOr
+};
+
+struct ExpressionInstruction
+{
+	ExpressionOpCode OpCode;
+	bool ConstantOperand;
+	uint16_t Jump;
+	int64_t Value; //Constant, token, label index or constant right operand
+};
+
+//Compact program generated from the RPN queue - tokens are resolved, constant sub-expressions are
+//folded and comparisons against constants don't go through the stack
+struct CompiledExpression
+{
+	vector<ExpressionInstruction> Code;
+	EvalResultType ResultType = EvalResultType::Numeric;
+	bool ResultFromToken = false;
+};
+
 struct ExpressionData
 {
 	vector<int64_t> RpnQueue;
 	vector<string> Labels;
+	shared_ptr<CompiledExpression> Compiled;
 };
 
 class ExpressionEvaluator
@@ -260,6 +327,12 @@ private:
 
 	bool ReturnBool(int64_t value, EvalResultType& resultType);
 
+	typedef int64_t(ExpressionEvaluator::*TokenValueFunc)(int64_t token, EvalResultType& resultType);
+	TokenValueFunc _getTokenValue = nullptr;
+
+	shared_ptr<CompiledExpression> Compile(ExpressionData& data);
+	int64_t EvaluateCompiled(ExpressionData& data, EvalResultType& resultType, MemoryOperationInfo& operationInfo, AddressInfo& addressInfo);
+
 	int64_t ProcessSharedTokens(string token);
 	
 	string GetNextToken(string expression, size_t &pos, ExpressionData &data, bool &success, bool previousTokenIsOp);
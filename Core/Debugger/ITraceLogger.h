@@ -34,5 +34,10 @@ public:
 	virtual void Clear() = 0;
 	virtual void SetOptions(TraceLoggerOptions options) = 0;
 
+	//Used by TraceLogFileSaver/TraceStore to generate the text for rows logged with AddRow
+	virtual uint32_t GetRecordSize() = 0;
+	virtual void FormatRecord(uint8_t* data, string& output) = 0;
+	virtual void GetRecordTraceRow(uint8_t* data, TraceRow& row) = 0;
+
 	__forceinline bool IsEnabled() { return _enabled; }
 };
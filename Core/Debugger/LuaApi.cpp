@@ -53,10 +53,10 @@
 #define checkinitdone() if(!_context->CheckInitDone()) { error("This function cannot be called outside a callback"); }
 #define checksavestateconditions() if(!_context->IsSaveStateAllowed()) { error("This function must be called inside an exec memory operation callback for the main CPU"); }
 
-Debugger* LuaApi::_debugger = nullptr;
-Emulator* LuaApi::_emu = nullptr;
-MemoryDumper* LuaApi::_memoryDumper = nullptr;
-ScriptingContext* LuaApi::_context = nullptr;
+thread_local Debugger* LuaApi::_debugger = nullptr;
+thread_local Emulator* LuaApi::_emu = nullptr;
+thread_local MemoryDumper* LuaApi::_memoryDumper = nullptr;
+thread_local ScriptingContext* LuaApi::_context = nullptr;
 
 enum class AccessCounterType
 {
@@ -94,6 +94,9 @@ int LuaApi::GetLibrary(lua_State *lua)
 		{ "write16", LuaApi::WriteMemory16 },
 		{ "read32", LuaApi::ReadMemory32 },
 		{ "write32", LuaApi::WriteMemory32 },
+		{ "readRange", LuaApi::ReadMemoryRange },
+		{ "writeRange", LuaApi::WriteMemoryRange },
+		{ "getMemoryChanges", LuaApi::GetMemoryChanges },
 
 		{ "readWord", LuaApi::ReadMemory16 }, //for backward compatibility
 		{ "writeWord", LuaApi::WriteMemory16 }, //for backward compatibility
@@ -336,6 +339,110 @@ int LuaApi::WriteMemory32(lua_State* lua)
 	return l.ReturnCount();
 }
 
+int LuaApi::ReadMemoryRange(lua_State* lua)
+{
+	LuaCallHelper l(lua);
+	l.ForceParamCount(4);
+	bool returnTable = l.ReadBool();
+	int type = l.ReadInteger();
+	MemoryType memType = (MemoryType)(type & 0xFF);
+	int length = l.ReadInteger();
+	int address = l.ReadInteger();
+	checkminparams(3);
+	errorCond(address < 0, "address must be >= 0");
+	errorCond(length < 0, "length must be >= 0");
+	checkEnum(MemoryType, memType, "invalid memory type");
+	errorCond((uint64_t)address + length > _memoryDumper->GetMemorySize(memType), "address range is out of bounds");
+
+	if(returnTable) {
+		vector<uint8_t> data(length);
+		if(length > 0) {
+			_memoryDumper->GetMemoryValues(memType, address, address + length - 1, data.data());
+		}
+
+		lua_createtable(lua, length, 0);
+		for(int i = 0; i < length; i++) {
+			lua_pushinteger(lua, data[i]);
+			lua_rawseti(lua, -2, i + 1);
+		}
+	} else {
+		//Read directly into the string's buffer
+		luaL_Buffer buffer;
+		char* data = luaL_buffinitsize(lua, &buffer, length);
+		if(length > 0) {
+			_memoryDumper->GetMemoryValues(memType, address, address + length - 1, (uint8_t*)data);
+		}
+		luaL_pushresultsize(&buffer, length);
+	}
+	return 1;
+}
+
+int LuaApi::WriteMemoryRange(lua_State* lua)
+{
+	LuaCallHelper l(lua);
+	int type = l.ReadInteger();
+	bool disableSideEffects = (type & 0x100) == 0x100;
+	MemoryType memType = (MemoryType)(type & 0xFF);
+	vector<uint8_t> data = l.ReadByteArray();
+	int address = l.ReadInteger();
+	checkparams();
+	errorCond(address < 0, "address must be >= 0");
+	checkEnum(MemoryType, memType, "invalid memory type");
+	errorCond((uint64_t)address + data.size() > _memoryDumper->GetMemorySize(memType), "address range is out of bounds");
+	if(data.size() > 0) {
+		_memoryDumper->SetMemoryValues(memType, address, data.data(), (uint32_t)data.size(), disableSideEffects);
+	}
+	return l.ReturnCount();
+}
+
+int LuaApi::GetMemoryChanges(lua_State* lua)
+{
+	LuaCallHelper l(lua);
+	int type = l.ReadInteger();
+	MemoryType memType = (MemoryType)(type & 0xFF);
+	checkparams();
+	checkEnum(MemoryType, memType, "invalid memory type");
+
+	uint32_t size = _memoryDumper->GetMemorySize(memType);
+	vector<uint8_t>& shadow = _context->GetMemoryShadow(memType);
+
+	//Compare against the memory directly when possible, otherwise read it into a temporary buffer
+	uint8_t* current = DebugUtilities::IsRelativeMemory(memType) ? nullptr : _memoryDumper->GetMemoryBuffer(memType);
+	vector<uint8_t> buffer;
+	if(!current) {
+		buffer.resize(size);
+		if(size > 0) {
+			_memoryDumper->GetMemoryValues(memType, 0, size - 1, buffer.data());
+		}
+		current = buffer.data();
+	}
+
+	lua_newtable(lua);
+	if(shadow.size() != size) {
+		//First call for this memory type, only take the snapshot
+		shadow.assign(current, current + size);
+		return 1;
+	}
+
+	uint8_t* prev = shadow.data();
+	for(uint32_t i = 0; i < size;) {
+		if(i + 8 <= size && memcmp(current + i, prev + i, 8) == 0) {
+			//Most of the memory is usually unchanged, skip 8 bytes at a time
+			i += 8;
+			continue;
+		}
+
+		if(current[i] != prev[i]) {
+			prev[i] = current[i];
+			lua_pushinteger(lua, i);
+			lua_pushinteger(lua, current[i]);
+			lua_settable(lua, -3);
+		}
+		i++;
+	}
+	return 1;
+}
+
 int LuaApi::ConvertAddress(lua_State *lua)
 {
 	LuaCallHelper l(lua);
@@ -703,7 +810,7 @@ int LuaApi::GetPixel(lua_State *lua)
 int LuaApi::GetMouseState(lua_State *lua)
 {
 	LuaCallHelper l(lua);
-	MousePosition pos = KeyManager::GetMousePosition();
+	MousePosition pos = _emu->GetKeyManager()->GetMousePosition();
 	checkparams();
 	lua_newtable(lua);
 	lua_pushintvalue(x, pos.X);
@@ -711,9 +818,9 @@ int LuaApi::GetMouseState(lua_State *lua)
 	lua_pushdoublevalue(relativeX, pos.RelativeX);
 	lua_pushdoublevalue(relativeY, pos.RelativeY);
 	
-	lua_pushboolvalue(left, KeyManager::IsMouseButtonPressed(MouseButton::LeftButton));
-	lua_pushboolvalue(middle, KeyManager::IsMouseButtonPressed(MouseButton::MiddleButton));
-	lua_pushboolvalue(right, KeyManager::IsMouseButtonPressed(MouseButton::RightButton));
+	lua_pushboolvalue(left, _emu->GetKeyManager()->IsMouseButtonPressed(MouseButton::LeftButton));
+	lua_pushboolvalue(middle, _emu->GetKeyManager()->IsMouseButtonPressed(MouseButton::MiddleButton));
+	lua_pushboolvalue(right, _emu->GetKeyManager()->IsMouseButtonPressed(MouseButton::RightButton));
 	return 1;
 }
 
@@ -817,9 +924,9 @@ int LuaApi::IsKeyPressed(lua_State *lua)
 	LuaCallHelper l(lua);
 	string keyName = l.ReadString();
 	checkparams();
-	uint32_t keyCode = KeyManager::GetKeyCode(keyName);
+	uint32_t keyCode = _emu->GetKeyManager()->GetKeyCode(keyName);
 	errorCond(keyCode == 0, "Invalid key name");
-	l.Return(KeyManager::IsKeyPressed(keyCode));
+	l.Return(_emu->GetKeyManager()->IsKeyPressed(keyCode));
 	return l.ReturnCount();
 }
 
@@ -32,6 +32,9 @@ public:
 	static int WriteMemory16(lua_State *lua);
 	static int ReadMemory32(lua_State* lua);
 	static int WriteMemory32(lua_State* lua);
+	static int ReadMemoryRange(lua_State* lua);
+	static int WriteMemoryRange(lua_State* lua);
+	static int GetMemoryChanges(lua_State* lua);
 
 	static int GetLabelAddress(lua_State* lua);
 	static int ConvertAddress(lua_State *lua);
@@ -93,10 +96,11 @@ public:
 private:
 	static FrameInfo InternalGetScreenSize();
 
-	static Emulator* _emu;
-	static Debugger* _debugger;
-	static MemoryDumper* _memoryDumper;
-	static ScriptingContext* _context;
+	//Set right before calling into Lua (thread_local so scripts in separate emulator instances can run in parallel)
+	static thread_local Emulator* _emu;
+	static thread_local Debugger* _debugger;
+	static thread_local MemoryDumper* _memoryDumper;
+	static thread_local ScriptingContext* _context;
 	
 	static std::pair<unique_ptr<BaseVideoFilter>, FrameInfo> GetRenderedFrame();
 	template<typename T> static void GenerateEnumDefinition(lua_State* lua, string enumName, unordered_set<T> excludedValues = {});
@@ -106,6 +106,40 @@ string LuaCallHelper::ReadString()
 	return str;
 }
 
+vector<uint8_t> LuaCallHelper::ReadByteArray()
+{
+	//Accepts either a string (1 byte per character) or a table of integers (-128 to 255, same as emu.write)
+	_paramCount++;
+	vector<uint8_t> data;
+	if(lua_type(_lua, -1) == LUA_TSTRING) {
+		size_t len;
+		const char* cstr = lua_tolstring(_lua, -1, &len);
+		data.assign((uint8_t*)cstr, (uint8_t*)cstr + len);
+	} else if(lua_istable(_lua, -1)) {
+		size_t len = lua_rawlen(_lua, -1);
+		data.resize(len);
+		for(size_t i = 0; i < len; i++) {
+			lua_rawgeti(_lua, -1, (lua_Integer)i + 1);
+			int isInteger = 0;
+			lua_Integer value = lua_tointegerx(_lua, -1, &isInteger);
+			if(!isInteger) {
+				luaL_error(_lua, "data[%d] is not an integer", (int)i + 1);
+				return {};
+			} else if(value > 255 || value < -128) {
+				luaL_error(_lua, "data[%d] value out of range", (int)i + 1);
+				return {};
+			}
+			data[i] = (uint8_t)value;
+			lua_pop(_lua, 1);
+		}
+	} else {
+		luaL_error(_lua, "data must be a string or a table of integers");
+		return {};
+	}
+	lua_pop(_lua, 1);
+	return data;
+}
+
 int LuaCallHelper::GetReference()
 {
 	_paramCount++;
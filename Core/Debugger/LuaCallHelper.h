@@ -27,6 +27,7 @@ public:
 	bool ReadBool(bool defaultValue = false);
 	uint32_t ReadInteger(uint32_t defaultValue = 0);
 	string ReadString();
+	vector<uint8_t> ReadByteArray();
 	int GetReference();
 
 	Nullable<bool> ReadOptionalBool();
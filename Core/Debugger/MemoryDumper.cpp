@@ -215,11 +215,11 @@ void MemoryDumper::GetMemoryState(MemoryType type, uint8_t *buffer)
 	}
 }
 
-void MemoryDumper::SetMemoryValues(MemoryType memoryType, uint32_t address, uint8_t* data, uint32_t length)
+void MemoryDumper::SetMemoryValues(MemoryType memoryType, uint32_t address, uint8_t* data, uint32_t length, bool disableSideEffects)
 {
 	DebugBreakHelper helper(_debugger);
 	for(uint32_t i = 0; i < length; i++) {
-		SetMemoryValue(memoryType, address+i, data[i], true);
+		SetMemoryValue(memoryType, address+i, data[i], disableSideEffects);
 	}
 }
 
@@ -285,6 +285,19 @@ void MemoryDumper::GetMemoryValues(MemoryType memoryType, uint32_t start, uint32
 {
 	int x = 0;
 	uint32_t size = GetMemorySize(memoryType);
+	if(start > end || start >= size) {
+		return;
+	}
+
+	if(!DebugUtilities::IsRelativeMemory(memoryType)) {
+		//Same as InternalGetMemoryValue's default case, but copies the whole range at once
+		uint8_t* src = GetMemoryBuffer(memoryType);
+		if(src) {
+			memcpy(output, src + start, std::min(end, size - 1) - start + 1);
+			return;
+		}
+	}
+
 	for(uint32_t i = start; i <= end && i < size; i++) {
 		output[x++] = InternalGetMemoryValue(memoryType, i);
 	}
@@ -47,6 +47,6 @@ public:
 	void SetMemoryValue16(MemoryType memoryType, uint32_t address, uint16_t value, bool disableSideEffects = true);
 	void SetMemoryValue32(MemoryType memoryType, uint32_t address, uint32_t value, bool disableSideEffects);
 	void SetMemoryValue(MemoryType memoryType, uint32_t address, uint8_t value, bool disableSideEffects = true);
-	void SetMemoryValues(MemoryType memoryType, uint32_t address, uint8_t* data, uint32_t length);
+	void SetMemoryValues(MemoryType memoryType, uint32_t address, uint8_t* data, uint32_t length, bool disableSideEffects = true);
 	void SetMemoryState(MemoryType type, uint8_t *buffer, uint32_t length);
 };
\ No newline at end of file
@@ -15,7 +15,7 @@
 #include "Utilities/magic_enum.hpp"
 #include "Shared/EventType.h"
 
-ScriptingContext* ScriptingContext::_context = nullptr;
+thread_local ScriptingContext* ScriptingContext::_context = nullptr;
 
 ScriptingContext::ScriptingContext(Debugger *debugger)
 {
@@ -177,14 +177,6 @@ string ScriptingContext::GetScriptName()
 	return _scriptName;
 }
 
-template<typename T>
-void ScriptingContext::CallMemoryCallback(AddressInfo relAddr, T &value, CallbackType type, CpuType cpuType)
-{
-	_allowSaveState = type == CallbackType::Exec && cpuType == _defaultCpuType;
-	InternalCallMemoryCallback(relAddr, value, type, cpuType);
-	_allowSaveState = false;
-}
-
 bool ScriptingContext::CheckInitDone()
 {
 	return _initDone;
@@ -207,6 +199,7 @@ void ScriptingContext::RegisterMemoryCallback(CallbackType type, int startAddr,
 	callback.Reference = reference;
 	callback.Cpu = cpuType;
 	callback.MemType = memType;
+	callback.Id = _nextCallbackId++;
 
 	if(DebugUtilities::IsPpuMemory(memType)) {
 		_debugger->GetScriptManager()->EnablePpuMemoryCallbacks();
@@ -215,6 +208,7 @@ void ScriptingContext::RegisterMemoryCallback(CallbackType type, int startAddr,
 	}
 
 	_callbacks[(int)type].push_back(callback);
+	BuildCallbackIndex(type);
 }
 
 void ScriptingContext::RefreshMemoryCallbackFlags()
@@ -248,6 +242,8 @@ void ScriptingContext::UnregisterMemoryCallback(CallbackType type, int startAddr
 
 		if(isMatch) {
 			_callbacks[(int)type].erase(_callbacks[(int)type].begin() + i);
+			_callbackRemoveCounter++;
+			BuildCallbackIndex(type);
 			break;
 		}
 	}
@@ -267,40 +263,87 @@ void ScriptingContext::UnregisterEventCallback(EventType type, int reference)
 	luaL_unref(_lua, LUA_REGISTRYINDEX, reference);
 }
 
-bool ScriptingContext::IsAddressMatch(MemoryCallback& callback, AddressInfo addr)
+void ScriptingContext::BuildCallbackIndex(CallbackType type)
 {
-	return addr.Type == callback.MemType && addr.Address >= (int32_t)callback.StartAddress && addr.Address <= (int32_t)callback.EndAddress;
+	vector<MemoryCallback>& callbacks = _callbacks[(int)type];
+	for(int cpu = 0; cpu <= (int)DebugUtilities::GetLastCpuType(); cpu++) {
+		unique_ptr<MemoryCallbackIndex>& cpuIndex = _callbackIndex[(int)type][cpu];
+		cpuIndex.reset();
+
+		vector<BreakpointRange> ranges[DebugUtilities::GetMemoryTypeCount()];
+		for(uint32_t i = 0; i < (uint32_t)callbacks.size(); i++) {
+			if((int)callbacks[i].Cpu == cpu) {
+				ranges[(int)callbacks[i].MemType].push_back({ (int32_t)callbacks[i].StartAddress, (int32_t)callbacks[i].EndAddress, i });
+			}
+		}
+
+		for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+			if(ranges[i].empty()) {
+				continue;
+			}
+
+			if(!cpuIndex) {
+				cpuIndex.reset(new MemoryCallbackIndex());
+			}
+			cpuIndex->Index[i].reset(new BreakpointIndex());
+			cpuIndex->Index[i]->Build(ranges[i]);
+			if(!DebugUtilities::IsRelativeMemory((MemoryType)i)) {
+				cpuIndex->HasAbsoluteCallbacks = true;
+			}
+		}
+	}
 }
 
 template<typename T>
 void ScriptingContext::InternalCallMemoryCallback(AddressInfo relAddr, T& value, CallbackType type, CpuType cpuType)
 {
-	if(_callbacks[(int)type].empty()) {
+	MemoryCallbackIndex* index = _callbackIndex[(int)type][(int)cpuType].get();
+
+	//Callbacks on a cpu memory type are matched against the cpu address, all others are matched against the absolute address
+	vector<uint32_t> matches;
+	if(DebugUtilities::IsRelativeMemory(relAddr.Type) && index->Index[(int)relAddr.Type]) {
+		index->Index[(int)relAddr.Type]->GetMatches<1>(relAddr.Address, matches);
+	}
+
+	size_t relMatchCount = matches.size();
+	if(index->HasAbsoluteCallbacks) {
+		AddressInfo absAddr = _debugger->GetAbsoluteAddress(relAddr);
+		if(absAddr.Address >= 0 && !DebugUtilities::IsRelativeMemory(absAddr.Type) && index->Index[(int)absAddr.Type]) {
+			index->Index[(int)absAddr.Type]->GetMatches<1>(absAddr.Address, matches);
+		}
+	}
+
+	if(matches.empty()) {
 		return;
 	}
 
+	if(relMatchCount > 0 && matches.size() > relMatchCount) {
+		//Call the callbacks in the same order as they were registered
+		std::sort(matches.begin(), matches.end());
+	}
+
+	//Callbacks can add/remove callbacks (which shifts the indexes), so keep a copy of the matches instead
+	vector<MemoryCallback>& callbacks = _callbacks[(int)type];
+	vector<MemoryCallback> matchedCallbacks;
+	matchedCallbacks.reserve(matches.size());
+	for(uint32_t i : matches) {
+		matchedCallbacks.push_back(callbacks[i]);
+	}
+
 	_context = this;
-	bool needTimerReset = true;
+	_timer.Reset();
 	lua_setwatchdogtimer(_lua, ScriptingContext::ExecutionCountHook, 1000);
 	LuaApi::SetContext(this);
-	for(MemoryCallback& callback : _callbacks[(int)type]) {
-		if(callback.Cpu != cpuType) {
-			continue;
-		} 
-
-		if(DebugUtilities::IsRelativeMemory(callback.MemType)) {
-			if(!IsAddressMatch(callback, relAddr)) {
+	uint32_t removeCounter = _callbackRemoveCounter;
+	for(MemoryCallback& callback : matchedCallbacks) {
+		if(removeCounter != _callbackRemoveCounter) {
+			//Check the id rather than the reference, a callback added by a previous callback can reuse a removed callback's reference
+			uint32_t id = callback.Id;
+			bool isRemoved = std::find_if(callbacks.begin(), callbacks.end(), [=](MemoryCallback& cb) { return cb.Id == id; }) == callbacks.end();
+			if(isRemoved) {
+				//A callback was removed by one of the previous callbacks
 				continue;
 			}
-		} else {
-			if(!IsAddressMatch(callback, _debugger->GetAbsoluteAddress(relAddr))) {
-				continue;
-			}
-		}
-
-		if(needTimerReset) {
-			_timer.Reset();
-			needTimerReset = false;
 		}
 
 		int top = lua_gettop(_lua);
@@ -341,6 +384,6 @@ int ScriptingContext::CallEventCallback(EventType type, CpuType cpuType)
 	return l.ReturnCount();
 }
 
-template void ScriptingContext::CallMemoryCallback<uint8_t>(AddressInfo relAddr, uint8_t& value, CallbackType type, CpuType cpuType);
-template void ScriptingContext::CallMemoryCallback<uint16_t>(AddressInfo relAddr, uint16_t& value, CallbackType type, CpuType cpuType);
-template void ScriptingContext::CallMemoryCallback<uint32_t>(AddressInfo relAddr, uint32_t& value, CallbackType type, CpuType cpuType);
+template void ScriptingContext::InternalCallMemoryCallback<uint8_t>(AddressInfo relAddr, uint8_t& value, CallbackType type, CpuType cpuType);
+template void ScriptingContext::InternalCallMemoryCallback<uint16_t>(AddressInfo relAddr, uint16_t& value, CallbackType type, CpuType cpuType);
+template void ScriptingContext::InternalCallMemoryCallback<uint32_t>(AddressInfo relAddr, uint32_t& value, CallbackType type, CpuType cpuType);
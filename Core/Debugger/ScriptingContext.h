@@ -4,6 +4,8 @@
 #include "Utilities/SimpleLock.h"
 #include "Utilities/Timer.h"
 #include "Debugger/DebugTypes.h"
+#include "Debugger/DebugUtilities.h"
+#include "Debugger/BreakpointIndex.h"
 #include "Shared/EventType.h"
 
 class Debugger;
@@ -23,6 +25,14 @@ struct MemoryCallback
 	CpuType Cpu;
 	MemoryType MemType;
 	int Reference;
+	uint32_t Id; //Unique per context (Lua can reuse a removed callback's reference)
+};
+
+//Address lookup tables for the memory callbacks of a single callback type + cpu type (one table per memory type)
+struct MemoryCallbackIndex
+{
+	bool HasAbsoluteCallbacks = false;
+	unique_ptr<BreakpointIndex> Index[DebugUtilities::GetMemoryTypeCount()];
 };
 
 enum class ScriptDrawSurface
@@ -34,7 +44,7 @@ enum class ScriptDrawSurface
 class ScriptingContext
 {
 private:
-	static ScriptingContext* _context;
+	static thread_local ScriptingContext* _context;
 	lua_State* _lua = nullptr;
 	Timer _timer;
 	EmuSettings* _settings = nullptr;
@@ -49,6 +59,9 @@ private:
 
 	ScriptDrawSurface _drawSurface = ScriptDrawSurface::ConsoleScreen;
 
+	//Copy of each memory type's content as of the last getMemoryChanges call
+	vector<uint8_t> _memoryShadows[DebugUtilities::GetMemoryTypeCount()];
+
 	static void ExecutionCountHook(lua_State* lua);
 	void LuaOpenLibs(lua_State* L, bool allowIoOsAccess);
 
@@ -57,11 +70,16 @@ protected:
 	bool _initDone = false;
 
 	vector<MemoryCallback> _callbacks[3];
+	uint32_t _callbackRemoveCounter = 0;
+	uint32_t _nextCallbackId = 0;
 	vector<int> _eventCallbacks[(int)EventType::LastValue + 1];
 
+	//Rebuilt whenever a callback is added/removed (null when there are no callbacks for that callback type/cpu type)
+	unique_ptr<MemoryCallbackIndex> _callbackIndex[3][(int)DebugUtilities::GetLastCpuType() + 1];
+
 	template<typename T> void InternalCallMemoryCallback(AddressInfo relAddr, T& value, CallbackType type, CpuType cpuType);
 
-	bool IsAddressMatch(MemoryCallback& callback, AddressInfo addr);
+	void BuildCallbackIndex(CallbackType type);
 
 public:
 	ScriptingContext(Debugger* debugger);
@@ -77,11 +95,24 @@ public:
 	void SetDrawSurface(ScriptDrawSurface surface) { _drawSurface = surface; }
 	ScriptDrawSurface GetDrawSurface() { return _drawSurface; }
 
-	template<typename T> void CallMemoryCallback(AddressInfo relAddr, T& value, CallbackType type, CpuType cpuType);
+	template<typename T>
+	__forceinline void CallMemoryCallback(AddressInfo relAddr, T& value, CallbackType type, CpuType cpuType)
+	{
+		if(!_callbackIndex[(int)type][(int)cpuType]) {
+			return;
+		}
+
+		_allowSaveState = type == CallbackType::Exec && cpuType == _defaultCpuType;
+		InternalCallMemoryCallback(relAddr, value, type, cpuType);
+		_allowSaveState = false;
+	}
+
 	int CallEventCallback(EventType type, CpuType cpuType);
 	bool CheckInitDone();
 	bool IsSaveStateAllowed();
 
+	vector<uint8_t>& GetMemoryShadow(MemoryType type) { return _memoryShadows[(int)type]; }
+
 	CpuType GetDefaultCpuType() { return _defaultCpuType; }
 	MemoryType GetDefaultMemType() { return _defaultMemType; }
 	
@@ -1,13 +1,14 @@
 #pragma once
 #include "pch.h"
 #include "Shared/RewindManager.h"
+#include "Shared/StateSnapshot.h"
 
 class Emulator;
 class IDebugger;
 
 struct StepBackCacheEntry
 {
-	stringstream SaveState;
+	StateSnapshot SaveState;
 	uint64_t Clock;
 };
 
@@ -0,0 +1,199 @@
+#include "pch.h"
+#include "Debugger/TraceLogFileSaver.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/ITraceLogger.h"
+#include "Debugger/DebugUtilities.h"
+#include "Debugger/DebugBreakHelper.h"
+
+TraceLogFileSaver::TraceLogFileSaver(Debugger* debugger)
+{
+	_debugger = debugger;
+	_writePos = 0;
+	_readPos = 0;
+	_stopFlag = false;
+}
+
+TraceLogFileSaver::~TraceLogFileSaver()
+{
+	InternalStopLogging();
+}
+
+void TraceLogFileSaver::StartLogging(string filename, bool binary)
+{
+	//Make sure the emulation thread isn't in the middle of logging a row
+	DebugBreakHelper helper(_debugger);
+	InternalStopLogging();
+
+	_outputFile.open(filename, ios::out | ios::binary);
+	if(!_outputFile) {
+		return;
+	}
+
+	if(!_buffer) {
+		_buffer.reset(new uint8_t[TraceLogFileSaver::BufferSize]);
+	}
+
+	_binary = binary;
+	_outputBuffer.clear();
+	_writePos = 0;
+	_readPos = 0;
+	_lastSignalPos = 0;
+
+	if(_binary) {
+		WriteFileHeader(_outputFile);
+	}
+
+	_stopFlag = false;
+	_writerThread = std::thread(&TraceLogFileSaver::WriterThread, this);
+	_enabled = true;
+}
+
+void TraceLogFileSaver::StopLogging()
+{
+	DebugBreakHelper helper(_debugger);
+	InternalStopLogging();
+}
+
+void TraceLogFileSaver::InternalStopLogging()
+{
+	if(_enabled) {
+		_enabled = false;
+
+		//The writer thread processes all pending rows before exiting
+		_stopFlag = true;
+		_signal.Signal();
+		_writerThread.join();
+
+		WriteOutputBuffer(true);
+		_outputFile.close();
+	}
+}
+
+void TraceLogFileSaver::Flush()
+{
+	if(!_enabled) {
+		return;
+	}
+
+	while(_readPos != _writePos) {
+		_signal.Signal();
+		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+	}
+}
+
+void TraceLogFileSaver::WriterThread()
+{
+	while(true) {
+		bool stop = _stopFlag;
+		if(!ProcessRecords()) {
+			if(stop) {
+				break;
+			}
+			_signal.Wait(10);
+		}
+	}
+}
+
+bool TraceLogFileSaver::ProcessRecords()
+{
+	uint64_t readPos = _readPos;
+	uint64_t writePos = _writePos.load(std::memory_order_acquire);
+	if(readPos == writePos) {
+		return false;
+	}
+
+	while(readPos < writePos) {
+		TraceLogRecordHeader* header = (TraceLogRecordHeader*)(_buffer.get() + (readPos & (TraceLogFileSaver::BufferSize - 1)));
+		if(!header->Padding) {
+			ProcessRecord(header);
+		}
+		readPos += header->Size;
+
+		if(_outputBuffer.size() > 32768) {
+			//Release the space used by the rows that were written to the file
+			WriteOutputBuffer(false);
+			_readPos.store(readPos, std::memory_order_release);
+		}
+	}
+
+	WriteOutputBuffer(false);
+	_readPos.store(readPos, std::memory_order_release);
+	return true;
+}
+
+void TraceLogFileSaver::ProcessRecord(TraceLogRecordHeader* header)
+{
+	if(_binary) {
+		_outputBuffer.append((char*)header, header->Size);
+	} else {
+		ITraceLogger* logger = _debugger->GetTraceLogger(header->Type);
+		if(logger) {
+			logger->FormatRecord((uint8_t*)(header + 1), _outputBuffer);
+		}
+	}
+}
+
+void TraceLogFileSaver::WriteOutputBuffer(bool force)
+{
+	if(!_outputBuffer.empty() && (force || _outputBuffer.size() > 32768)) {
+		_outputFile.write(_outputBuffer.data(), _outputBuffer.size());
+		_outputBuffer.clear();
+	}
+}
+
+void TraceLogFileSaver::WriteFileHeader(ofstream& file)
+{
+	file.write("MTRC", 4);
+	file.write((char*)&TraceLogFileSaver::BinaryFormatVersion, sizeof(uint32_t));
+}
+
+bool TraceLogFileSaver::ReadFileHeader(ifstream& file)
+{
+	char header[4] = {};
+	uint32_t version = 0;
+	file.read(header, 4);
+	file.read((char*)&version, sizeof(version));
+	return file && memcmp(header, "MTRC", 4) == 0 && version == TraceLogFileSaver::BinaryFormatVersion;
+}
+
+bool TraceLogFileSaver::ConvertToText(string binaryFile, string textFile)
+{
+	ifstream input(binaryFile, ios::in | ios::binary);
+	if(!input || !ReadFileHeader(input)) {
+		return false;
+	}
+
+	ofstream output(textFile, ios::out | ios::binary);
+	if(!output) {
+		return false;
+	}
+
+	//Records contain the raw cpu state structs, so the file can only be converted by the same build that created it
+	vector<uint8_t> record;
+	string text;
+	TraceLogRecordHeader header = {};
+	while(input.read((char*)&header, sizeof(header))) {
+		if(header.Size < sizeof(header) || (int)header.Type > (int)DebugUtilities::GetLastCpuType()) {
+			return false;
+		}
+
+		record.resize(header.Size - sizeof(header));
+		if(!input.read((char*)record.data(), record.size())) {
+			return false;
+		}
+
+		ITraceLogger* logger = _debugger->GetTraceLogger(header.Type);
+		if(!logger || record.size() < logger->GetRecordSize()) {
+			return false;
+		}
+
+		logger->FormatRecord(record.data(), text);
+		if(text.size() > 32768) {
+			output << text;
+			text.clear();
+		}
+	}
+
+	output << text;
+	return true;
+}
@@ -1,48 +1,109 @@
 #pragma once
 #include "pch.h"
+#include <thread>
+#include "Utilities/AutoResetEvent.h"
 
+class Debugger;
+enum class CpuType : uint8_t;
+
+struct TraceLogRecordHeader
+{
+	uint32_t Size; //Size of the record, including the header
+	CpuType Type;
+	bool Padding; //Filler at the end of the ring buffer, contains no data
+};
+
+//Writes the trace logger's rows to a file.
+//The emulation thread only copies each row's binary data (cpu state, disassembly info, ppu state) into a ring buffer.
+//A separate thread either generates the text for each row (text mode), or writes the binary data as is (binary mode).
+//Binary logs can be converted to text later with ConvertToText, which uses the current trace logger options.
 class TraceLogFileSaver
 {
 private:
+	static constexpr uint32_t BufferSize = 0x800000;
+	static constexpr uint32_t SignalThreshold = 0x10000;
+	static constexpr uint32_t BinaryFormatVersion = 1;
+
+	Debugger* _debugger = nullptr;
+
 	bool _enabled = false;
-	string _outputFilepath;
-	string _outputBuffer;
+	bool _binary = false;
 	ofstream _outputFile;
+	string _outputBuffer;
+
+	unique_ptr<uint8_t[]> _buffer;
+	atomic<uint64_t> _writePos;
+	atomic<uint64_t> _readPos;
+	uint64_t _recordStart = 0;
+	uint64_t _lastSignalPos = 0;
+
+	std::thread _writerThread;
+	atomic<bool> _stopFlag;
+	AutoResetEvent _signal;
+
+	void InternalStopLogging();
+	void WriterThread();
+	bool ProcessRecords();
+	void ProcessRecord(TraceLogRecordHeader* header);
+	void WriteOutputBuffer(bool force);
+
+	static void WriteFileHeader(ofstream& file);
+	static bool ReadFileHeader(ifstream& file);
 
 public:
-	~TraceLogFileSaver()
-	{
-		StopLogging();
-	}
+	TraceLogFileSaver(Debugger* debugger);
+	~TraceLogFileSaver();
 
-	void StartLogging(string filename)
-	{
-		_outputBuffer.clear();
-		_outputFile.open(filename, ios::out | ios::binary);
-		_enabled = true;
-	}
+	void StartLogging(string filename, bool binary = false);
+	void StopLogging();
+
+	//Waits until the writer thread has processed every row logged so far
+	void Flush();
+
+	bool ConvertToText(string binaryFile, string textFile);
 
-	void StopLogging()
+	__forceinline bool IsEnabled() { return _enabled; }
+
+	//Reserves space for a row in the buffer, EndRecord must be called once the data is written
+	__forceinline uint8_t* BeginRecord(CpuType type, uint32_t size)
 	{
-		if(_enabled) {
-			_enabled = false;
-			if(_outputFile) {
-				if(!_outputBuffer.empty()) {
-					_outputFile << _outputBuffer;
-				}
-				_outputFile.close();
-			}
+		uint32_t recordSize = (sizeof(TraceLogRecordHeader) + size + 7) & ~0x07;
+		uint64_t pos = _writePos.load(std::memory_order_relaxed);
+		uint32_t offset = (uint32_t)(pos & (BufferSize - 1));
+
+		//Records are never split, add padding and restart at the beginning of the buffer when there is not enough space left
+		uint32_t padding = offset + recordSize > BufferSize ? BufferSize - offset : 0;
+		while(pos + padding + recordSize - _readPos.load(std::memory_order_acquire) > BufferSize) {
+			//Buffer is full, wait for the writer thread to catch up
+			_signal.Signal();
+			std::this_thread::yield();
 		}
-	}
 
-	__forceinline bool IsEnabled() { return _enabled; }
+		if(padding) {
+			TraceLogRecordHeader* header = (TraceLogRecordHeader*)(_buffer.get() + offset);
+			header->Size = padding;
+			header->Padding = true;
+			pos += padding;
+			offset = 0;
+		}
 
-	void Log(string& log)
+		TraceLogRecordHeader* header = (TraceLogRecordHeader*)(_buffer.get() + offset);
+		header->Size = recordSize;
+		header->Type = type;
+		header->Padding = false;
+		_recordStart = pos;
+		return (uint8_t*)(header + 1);
+	}
+
+	__forceinline void EndRecord()
 	{
-		_outputBuffer += log + '\n';
-		if(_outputBuffer.size() > 32768) {
-			_outputFile << _outputBuffer;
-			_outputBuffer.clear();
+		uint64_t pos = _recordStart + ((TraceLogRecordHeader*)(_buffer.get() + (_recordStart & (BufferSize - 1))))->Size;
+		_writePos.store(pos, std::memory_order_release);
+
+		if(pos - _lastSignalPos >= SignalThreshold) {
+			//The writer thread also wakes up periodically, only signal it when a decent amount of data is pending
+			_lastSignalPos = pos;
+			_signal.Signal();
 		}
 	}
-};
\ No newline at end of file
+};
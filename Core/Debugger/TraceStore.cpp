@@ -0,0 +1,192 @@
+#include "pch.h"
+#include "Debugger/TraceStore.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/ITraceLogger.h"
+#include "Debugger/DebugBreakHelper.h"
+#include "Shared/Emulator.h"
+
+TraceStore::TraceStore(Debugger* debugger)
+{
+	_debugger = debugger;
+	_rowCount = 0;
+}
+
+TraceStore::~TraceStore()
+{
+	InternalClear();
+}
+
+bool TraceStore::Start(string filename)
+{
+	//Make sure the emulation thread isn't in the middle of logging a row
+	DebugBreakHelper helper(_debugger);
+	auto lock = _lock.AcquireSafe();
+
+	InternalClear();
+
+	//Every row uses the same amount of space, large enough for the cpu with the largest state
+	uint32_t recordSize = 0;
+	for(CpuType type : _debugger->GetEmulator()->GetCpuTypes()) {
+		ITraceLogger* logger = _debugger->GetTraceLogger(type);
+		if(logger) {
+			recordSize = std::max(recordSize, logger->GetRecordSize());
+		}
+	}
+
+	_rowSize = (TraceStore::HeaderSize + recordSize + 7) & ~0x07;
+	_rowsPerChunk = TraceStore::ChunkSize / _rowSize;
+
+	if(TraceStore::ChunkSize % MemoryMappedFile::GetViewAlignment() != 0 || !_file.Open(filename)) {
+		return false;
+	}
+
+	_chunks.reset(new uint8_t*[TraceStore::MaxChunkCount]);
+	_index.reset(new ChunkIndex[TraceStore::MaxChunkCount]);
+	_chunkCount = 0;
+	_rowCount = 0;
+	_writePtr = nullptr;
+	_writeRemaining = 0;
+	_enabled = true;
+	return true;
+}
+
+void TraceStore::Stop()
+{
+	DebugBreakHelper helper(_debugger);
+	_enabled = false;
+}
+
+void TraceStore::Clear()
+{
+	DebugBreakHelper helper(_debugger);
+	auto lock = _lock.AcquireSafe();
+	InternalClear();
+}
+
+void TraceStore::InternalClear()
+{
+	_enabled = false;
+	for(uint32_t i = 0; i < _chunkCount; i++) {
+		MemoryMappedFile::Unmap(_chunks[i], TraceStore::ChunkSize);
+	}
+	_chunkCount = 0;
+	_rowCount = 0;
+	_writeRemaining = 0;
+	_file.Close(true);
+}
+
+bool TraceStore::AddChunk()
+{
+	uint8_t* chunk = nullptr;
+	if(_chunkCount < TraceStore::MaxChunkCount) {
+		uint64_t offset = (uint64_t)_chunkCount * TraceStore::ChunkSize;
+		if(_file.SetSize(offset + TraceStore::ChunkSize)) {
+			chunk = _file.Map(offset, TraceStore::ChunkSize);
+		}
+	}
+
+	if(!chunk) {
+		//Out of space, keep the rows recorded so far
+		_enabled = false;
+		return false;
+	}
+
+	//The chunk's pointer must be set before any of its rows are counted in _rowCount (readers don't lock)
+	_chunks[_chunkCount] = chunk;
+	_chunkCount++;
+	_writePtr = chunk;
+	_writeRemaining = _rowsPerChunk;
+	return true;
+}
+
+bool TraceStore::RowMatches(TraceStoreRowHeader* row, TraceStoreFilter& filter)
+{
+	if(filter.FilterCpu && row->Type != filter.Cpu) {
+		return false;
+	}
+	if(filter.FilterPc && (row->ProgramCounter < filter.PcStart || row->ProgramCounter > filter.PcEnd)) {
+		return false;
+	}
+	if(filter.FilterAddress && (row->EffectiveAddress < filter.AddressStart || row->EffectiveAddress > filter.AddressEnd)) {
+		return false;
+	}
+	return true;
+}
+
+bool TraceStore::ChunkMatches(ChunkIndex& index, TraceStoreFilter& filter)
+{
+	if(filter.FilterCpu && !(index.CpuMask & (1 << (int)filter.Cpu))) {
+		return false;
+	}
+	if(filter.FilterPc && (index.MaxPc < filter.PcStart || index.MinPc > filter.PcEnd)) {
+		return false;
+	}
+	if(filter.FilterAddress && (index.MaxAddress < filter.AddressStart || index.MinAddress > filter.AddressEnd)) {
+		return false;
+	}
+	return true;
+}
+
+int64_t TraceStore::FindRow(uint32_t frame, int32_t scanline)
+{
+	auto lock = _lock.AcquireSafe();
+	uint64_t rowCount = _rowCount.load(std::memory_order_acquire);
+
+	for(uint64_t row = 0; row < rowCount;) {
+		uint32_t chunk = (uint32_t)(row / _rowsPerChunk);
+		if(IsChunkComplete(chunk, rowCount) && _index[chunk].LastFrame < frame) {
+			row = (uint64_t)(chunk + 1) * _rowsPerChunk;
+			continue;
+		}
+
+		TraceStoreRowHeader* header = GetRow(row);
+		if(header->FrameCount > frame || (header->FrameCount == frame && header->Scanline >= scanline)) {
+			return (int64_t)row;
+		}
+		row++;
+	}
+
+	return -1;
+}
+
+uint32_t TraceStore::Search(TraceStoreFilter filter, uint64_t startRow, uint64_t results[], uint32_t maxResults)
+{
+	auto lock = _lock.AcquireSafe();
+	uint64_t rowCount = _rowCount.load(std::memory_order_acquire);
+
+	uint32_t count = 0;
+	for(uint64_t row = startRow; row < rowCount && count < maxResults;) {
+		uint32_t chunk = (uint32_t)(row / _rowsPerChunk);
+		if(IsChunkComplete(chunk, rowCount) && !ChunkMatches(_index[chunk], filter)) {
+			row = (uint64_t)(chunk + 1) * _rowsPerChunk;
+			continue;
+		}
+
+		if(RowMatches(GetRow(row), filter)) {
+			results[count++] = row;
+		}
+		row++;
+	}
+
+	return count;
+}
+
+uint32_t TraceStore::GetRows(uint64_t startRow, TraceRow output[], uint32_t maxRowCount)
+{
+	auto lock = _lock.AcquireSafe();
+	uint64_t rowCount = _rowCount.load(std::memory_order_acquire);
+
+	uint32_t count = 0;
+	for(uint64_t row = startRow; row < rowCount && count < maxRowCount; row++) {
+		TraceStoreRowHeader* header = GetRow(row);
+		ITraceLogger* logger = _debugger->GetTraceLogger(header->Type);
+		if(logger) {
+			logger->GetRecordTraceRow((uint8_t*)header + TraceStore::HeaderSize, output[count]);
+		} else {
+			output[count] = {};
+		}
+		count++;
+	}
+
+	return count;
+}
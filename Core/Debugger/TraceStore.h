@@ -0,0 +1,134 @@
+#pragma once
+#include "pch.h"
+#include "Debugger/ITraceLogger.h"
+#include "Utilities/MemoryMappedFile.h"
+#include "Utilities/SimpleLock.h"
+
+class Debugger;
+enum class CpuType : uint8_t;
+
+struct TraceStoreRowHeader
+{
+	uint32_t ProgramCounter;
+	int32_t EffectiveAddress;
+	uint32_t FrameCount;
+	int32_t Scanline;
+	CpuType Type;
+};
+
+struct TraceStoreFilter
+{
+	bool FilterCpu;
+	CpuType Cpu;
+
+	bool FilterPc;
+	uint32_t PcStart;
+	uint32_t PcEnd;
+
+	bool FilterAddress;
+	int32_t AddressStart;
+	int32_t AddressEnd;
+};
+
+//Execution trace that isn't limited to the trace logger's in-memory buffer.
+//Rows are stored in fixed-size slots in a memory-mapped scratch file, which is grown one chunk at a time.
+//Each chunk has a small index (PC/address/frame ranges, cpu types) that lets searches skip chunks that can't match.
+class TraceStore
+{
+private:
+	static constexpr uint32_t ChunkSize = 0x1000000;
+	static constexpr uint32_t MaxChunkCount = 4096;
+	static constexpr uint32_t HeaderSize = (sizeof(TraceStoreRowHeader) + 7) & ~0x07;
+
+	struct ChunkIndex
+	{
+		uint32_t MinPc;
+		uint32_t MaxPc;
+		int32_t MinAddress;
+		int32_t MaxAddress;
+		uint32_t FirstFrame;
+		uint32_t LastFrame;
+		uint32_t CpuMask;
+	};
+
+	Debugger* _debugger = nullptr;
+	MemoryMappedFile _file;
+	SimpleLock _lock;
+
+	bool _enabled = false;
+	uint32_t _rowSize = 0;
+	uint32_t _rowsPerChunk = 0;
+
+	unique_ptr<uint8_t*[]> _chunks;
+	unique_ptr<ChunkIndex[]> _index;
+	uint32_t _chunkCount = 0;
+	atomic<uint64_t> _rowCount;
+
+	//Only used by the emulation thread
+	uint8_t* _writePtr = nullptr;
+	uint32_t _writeRemaining = 0;
+
+	__noinline bool AddChunk();
+	void InternalClear();
+
+	__forceinline TraceStoreRowHeader* GetRow(uint64_t row)
+	{
+		return (TraceStoreRowHeader*)(_chunks[row / _rowsPerChunk] + (row % _rowsPerChunk) * _rowSize);
+	}
+
+	bool IsChunkComplete(uint32_t chunk, uint64_t rowCount) { return (uint64_t)(chunk + 1) * _rowsPerChunk <= rowCount; }
+	bool RowMatches(TraceStoreRowHeader* row, TraceStoreFilter& filter);
+	bool ChunkMatches(ChunkIndex& index, TraceStoreFilter& filter);
+
+public:
+	TraceStore(Debugger* debugger);
+	~TraceStore();
+
+	//Starts recording rows to a new scratch file (any previous content is discarded)
+	bool Start(string filename);
+
+	//Stops recording, the rows recorded so far remain available until Clear() is called
+	void Stop();
+	void Clear();
+
+	__forceinline bool IsEnabled() { return _enabled; }
+	uint64_t GetRowCount() { return _rowCount; }
+
+	//Returns the first row logged at or after the given frame/scanline, or -1 if there is none
+	int64_t FindRow(uint32_t frame, int32_t scanline);
+
+	//Returns the indexes of the rows matching the filter, starting from startRow (next page starts after the last result)
+	uint32_t Search(TraceStoreFilter filter, uint64_t startRow, uint64_t results[], uint32_t maxResults);
+
+	uint32_t GetRows(uint64_t startRow, TraceRow output[], uint32_t maxRowCount);
+
+	//Returns a buffer for the row's data, EndRow must be called once the data is written
+	__forceinline uint8_t* BeginRow(TraceStoreRowHeader& header)
+	{
+		if(_writeRemaining == 0 && !AddChunk()) {
+			return nullptr;
+		}
+
+		ChunkIndex& index = _index[_chunkCount - 1];
+		if(_writeRemaining == _rowsPerChunk) {
+			index = { header.ProgramCounter, header.ProgramCounter, header.EffectiveAddress, header.EffectiveAddress, header.FrameCount, header.FrameCount, 0 };
+		} else {
+			index.MinPc = std::min(index.MinPc, header.ProgramCounter);
+			index.MaxPc = std::max(index.MaxPc, header.ProgramCounter);
+			index.MinAddress = std::min(index.MinAddress, header.EffectiveAddress);
+			index.MaxAddress = std::max(index.MaxAddress, header.EffectiveAddress);
+			index.LastFrame = header.FrameCount;
+		}
+		index.CpuMask |= 1 << (int)header.Type;
+
+		*(TraceStoreRowHeader*)_writePtr = header;
+		return _writePtr + HeaderSize;
+	}
+
+	__forceinline void EndRow()
+	{
+		_writePtr += _rowSize;
+		_writeRemaining--;
+		_rowCount.store(_rowCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+};
@@ -55,7 +55,7 @@ RowDataType GbaTraceLogger::GetFormatTagType(string& tag)
 	}
 }
 
-void GbaTraceLogger::GetTraceRow(string &output, GbaCpuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo)
+void GbaTraceLogger::GetTraceRow(string &output, GbaCpuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 {
 	for(RowPart& rowPart : _rowParts) {
 		switch(rowPart.DataType) {
@@ -111,7 +111,7 @@ void GbaTraceLogger::GetTraceRow(string &output, GbaCpuState &cpuState, TraceLog
 				break;
 			}
 
-			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo); break;
+			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo, capturedAddress); break;
 		}
 	}
 }
@@ -18,7 +18,7 @@ protected:
 public:
 	GbaTraceLogger(Debugger* debugger, IDebugger* cpuDebugger, GbaPpu* ppu);
 	
-	void GetTraceRow(string& output, GbaCpuState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo);
+	void GetTraceRow(string& output, GbaCpuState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress);
 	void LogPpuState();
 
 	__forceinline uint32_t GetProgramCounter(GbaCpuState& state) { return state.Pipeline.Execute.Address; }
@@ -24,12 +24,17 @@
 #include "Utilities/Serializer.h"
 #include "Utilities/StringUtilities.h"
 
+std::once_flag GbaConsole::_cpuTablesInitFlag;
+
 GbaConsole::GbaConsole(Emulator* emu)
 {
 	_emu = emu;
 
-	GbaCpu::StaticInit();
-	DummyGbaCpu::StaticInit();
+	//Only build the tables once, other instances may already be running code using them
+	std::call_once(_cpuTablesInitFlag, []() {
+		GbaCpu::StaticInit();
+		DummyGbaCpu::StaticInit();
+	});
 }
 
 GbaConsole::~GbaConsole()
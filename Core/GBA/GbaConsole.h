@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include <mutex>
 #include "GBA/GbaTypes.h"
 #include "Debugger/DebugTypes.h"
 #include "Shared/SettingTypes.h"
@@ -33,6 +34,9 @@ public:
 	static constexpr int ExtWorkRamSize = 0x40000;
 
 private:
+	//The CPU opcode tables are static, shared by all instances (e.g parallel headless/test farm instances)
+	static std::once_flag _cpuTablesInitFlag;
+
 
 	Emulator* _emu = nullptr;
 
@@ -7,6 +7,7 @@
 #include "Shared/RewindManager.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoKernels.h"
 
 GbaDefaultVideoFilter::GbaDefaultVideoFilter(Emulator* emu, bool applyNtscFilter) : BaseVideoFilter(emu), _ntscFilter(emu)
 {
@@ -93,10 +94,10 @@ void GbaDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 {
 	uint32_t* out = GetOutputBuffer();
 
-	for(uint32_t i = 0; i < GbaConstants::ScreenHeight; i++) {
-		for(uint32_t j = 0; j < GbaConstants::ScreenWidth; j++) {
-			out[i * GbaConstants::ScreenWidth + j] = GetPixel(ppuOutputBuffer, i * GbaConstants::ScreenWidth + j);
-		}
+	if(_blendFrames) {
+		VideoKernels::ConvertAndBlendPixels(_calculatedPalette, _prevFrame, ppuOutputBuffer, out, GbaConstants::PixelCount, 0x7FFF);
+	} else {
+		VideoKernels::ConvertPixels(_calculatedPalette, ppuOutputBuffer, out, GbaConstants::PixelCount, 0x7FFF);
 	}
 
 	if(_blendFrames) {
@@ -104,20 +105,6 @@ void GbaDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 	}
 
 	if(_applyNtscFilter) {
-		_ntscFilter.ApplyFilter(out, GbaConstants::ScreenWidth, GbaConstants::ScreenHeight, 0);
-	}
-}
-
-uint32_t GbaDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
-{
-	if(_blendFrames) {
-		return BlendPixels(_calculatedPalette[_prevFrame[offset] & 0x7FFF], _calculatedPalette[ppuFrame[offset] & 0x7FFF]);
-	} else {
-		return _calculatedPalette[ppuFrame[offset] & 0x7FFF];
+		_ntscFilter.ApplyFilter(out, GbaConstants::ScreenWidth, GbaConstants::ScreenHeight, 0, GetWorkerPool());
 	}
 }
-
-uint32_t GbaDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
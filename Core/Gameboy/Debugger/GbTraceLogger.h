@@ -18,7 +18,7 @@ protected:
 public:
 	GbTraceLogger(Debugger* debugger, IDebugger* cpuDebugger, GbPpu* ppu);
 	
-	void GetTraceRow(string& output, GbCpuState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo);
+	void GetTraceRow(string& output, GbCpuState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress);
 	void LogPpuState();
 
 	__forceinline uint32_t GetProgramCounter(GbCpuState& state) { return state.PC; }
@@ -151,9 +151,28 @@ void Gameboy::PowerOn(SuperGameboy *sgb)
 }
 
 void Gameboy::Run(uint64_t runUntilClock)
+{
+	//The instantiation is picked once per call (the SGB runs the Game Boy in short slices between its syncs)
+	if(_emu->IsDebugging()) {
+		RunCpu<true>(runUntilClock);
+	} else {
+		RunCpu<false>(runUntilClock);
+	}
+}
+
+template<bool debuggerEnabled>
+void Gameboy::RunCpu(uint64_t runUntilClock)
 {
 	while(_cpu->GetCycleCount() < runUntilClock) {
-		_cpu->Exec();
+		_cpu->Exec<debuggerEnabled>();
+	}
+}
+
+template<bool debuggerEnabled>
+void Gameboy::RunCpuFrame(uint32_t frameCount)
+{
+	while(frameCount == _ppu->GetFrameCount()) {
+		_cpu->Exec<debuggerEnabled>();
 	}
 }
 
@@ -504,8 +523,12 @@ GameboyModel Gameboy::GetEffectiveModel(GameboyHeader& header)
 void Gameboy::RunFrame()
 {
 	uint32_t frameCount = _ppu->GetFrameCount();
-	while(frameCount == _ppu->GetFrameCount()) {
-		_cpu->Exec();
+	//The instantiation is picked once per frame, like on the GBA (the debugger is attached between frames,
+	//and the <true> instantiation still checks for it at runtime if it is detached mid-frame)
+	if(_emu->IsDebugging()) {
+		RunCpuFrame<true>(frameCount);
+	} else {
+		RunCpuFrame<false>(frameCount);
 	}
 
 	_apu->Run();
@@ -64,6 +64,9 @@ private:
 	void Init(GbCart* cart, std::vector<uint8_t>& romData, uint32_t cartRamSize, bool hasBattery);
 	GameboyModel GetEffectiveModel(GameboyHeader& header);
 
+	template<bool debuggerEnabled> void RunCpu(uint64_t runUntilClock);
+	template<bool debuggerEnabled> void RunCpuFrame(uint32_t frameCount);
+
 public:
 	static constexpr int HeaderOffset = 0x134;
 
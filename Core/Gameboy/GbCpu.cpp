@@ -48,6 +48,7 @@ bool GbCpu::HandleStoppedState()
 	return false;
 }
 
+template<bool debuggerEnabled>
 void GbCpu::Exec()
 {
 #ifndef DUMMYCPU
@@ -97,10 +98,12 @@ void GbCpu::Exec()
 
 	if(_state.HaltCounter) {
 		if(_state.HaltBug) {
-			ProcessHaltBug();
+			ProcessHaltBug<debuggerEnabled>();
 		} else {
 #ifndef DUMMYCPU
-			_emu->ProcessHaltedCpu<CpuType::Gameboy>();
+			if constexpr(debuggerEnabled) {
+				_emu->ProcessHaltedCpu<CpuType::Gameboy>();
+			}
 			if(_state.HaltCounter > 1) {
 				ProcessCgbSpeedSwitch();
 			}
@@ -113,7 +116,9 @@ void GbCpu::Exec()
 		}
 
 #ifndef DUMMYCPU
-		_emu->ProcessInstruction<CpuType::Gameboy>();
+		if constexpr(debuggerEnabled) {
+			_emu->ProcessInstruction<CpuType::Gameboy>();
+		}
 #endif
 		ExecOpCode(ReadOpCode());
 	}
@@ -121,6 +126,9 @@ void GbCpu::Exec()
 	ProcessNextCycleStart();
 }
 
+template void GbCpu::Exec<false>();
+template void GbCpu::Exec<true>();
+
 void GbCpu::PowerOn()
 {
 	ProcessNextCycleStart();
@@ -150,6 +158,7 @@ void GbCpu::ProcessNextCycleStart()
 	}
 }
 
+template<bool debuggerEnabled>
 void GbCpu::ProcessHaltBug()
 {
 	if(_state.EiPending) {
@@ -158,7 +167,9 @@ void GbCpu::ProcessHaltBug()
 	}
 
 #ifndef DUMMYCPU
-	_emu->ProcessInstruction<CpuType::Gameboy>();
+	if constexpr(debuggerEnabled) {
+		_emu->ProcessInstruction<CpuType::Gameboy>();
+	}
 #endif
 
 	//HALT bug, execution continues, but PC isn't incremented for the first byte
@@ -34,7 +34,7 @@ private:
 	void ExecOpCode(uint8_t opCode);
 
 	void ProcessCgbSpeedSwitch();
-	__noinline void ProcessHaltBug();
+	template<bool debuggerEnabled> __noinline void ProcessHaltBug();
 
 	__forceinline void ExecCpuCycle();
 	__forceinline void ExecMasterCycle();
@@ -171,7 +171,9 @@ public:
 
 	uint64_t GetCycleCount() { return _state.CycleCount; }
 
-	void Exec();
+	//The instruction/halted cpu debugger hooks are only compiled into the <true> instantiation
+	//(memory and PPU hooks are shared by both and still check for the debugger at runtime, as on the GBA)
+	template<bool debuggerEnabled = true> void Exec();
 	void PowerOn();
 
 	void Serialize(Serializer& s) override;
@@ -8,6 +8,7 @@
 #include "Shared/RewindManager.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoKernels.h"
 
 GbDefaultVideoFilter::GbDefaultVideoFilter(Emulator* emu, bool applyNtscFilter) : BaseVideoFilter(emu), _ntscFilter(emu)
 {
@@ -101,10 +102,10 @@ void GbDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 
 	uint32_t* out = GetOutputBuffer();
 	
-	for(uint32_t i = 0; i < GbConstants::ScreenHeight; i++) {
-		for(uint32_t j = 0; j < GbConstants::ScreenWidth; j++) {
-			out[i * GbConstants::ScreenWidth + j] = GetPixel(ppuOutputBuffer, i * GbConstants::ScreenWidth + j);
-		}
+	if(_blendFrames) {
+		VideoKernels::ConvertAndBlendPixels(_calculatedPalette, _prevFrame, ppuOutputBuffer, out, GbConstants::PixelCount);
+	} else {
+		VideoKernels::ConvertPixels(_calculatedPalette, ppuOutputBuffer, out, GbConstants::PixelCount);
 	}
 
 	if(_blendFrames) {
@@ -112,20 +113,6 @@ void GbDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 	}
 
 	if(_applyNtscFilter) {
-		_ntscFilter.ApplyFilter(out, GbConstants::ScreenWidth, GbConstants::ScreenHeight, 0);
-	}
-}
-
-uint32_t GbDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
-{
-	if(_blendFrames) {
-		return BlendPixels(_calculatedPalette[_prevFrame[offset]], _calculatedPalette[ppuFrame[offset]]);
-	} else {
-		return _calculatedPalette[ppuFrame[offset]];
+		_ntscFilter.ApplyFilter(out, GbConstants::ScreenWidth, GbConstants::ScreenHeight, 0, GetWorkerPool());
 	}
 }
-
-uint32_t GbDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
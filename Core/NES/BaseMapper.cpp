@@ -165,11 +165,20 @@ void BaseMapper::SetCpuMemoryMapping(uint16_t startAddr, uint16_t endAddr, uint8
 			_prgPages[i] = nullptr;
 			_prgMemoryAccess[i] = MemoryAccessType::NoAccess;
 		}
+		UpdateDirectPage((uint8_t)i);
 
 		sourceOffset += 0x100;
 	}
 }
 
+void BaseMapper::UpdateDirectPage(uint8_t page)
+{
+	bool canRead = _allowDirectRead && (_prgMemoryAccess[page] & MemoryAccessType::Read) && !(_allowRegisterRead && _isReadRegisterPage[page]);
+	bool canWrite = _allowDirectWrite && (_prgMemoryAccess[page] & MemoryAccessType::Write) && !_isWriteRegisterPage[page];
+	_prgReadPages[page] = canRead ? _prgPages[page] : nullptr;
+	_prgWritePages[page] = canWrite ? _prgPages[page] : nullptr;
+}
+
 void BaseMapper::RemoveCpuMemoryMapping(uint16_t startAddr, uint16_t endAddr)
 {
 	//Unmap this section of memory (causing open bus behavior)
@@ -508,6 +517,7 @@ void BaseMapper::AddRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOp
 			_isWriteRegisterAddr[i] = true;
 		}
 	}
+	UpdateRegisterPages(startAddr, endAddr);
 }
 
 void BaseMapper::RemoveRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOperation operation)
@@ -520,6 +530,22 @@ void BaseMapper::RemoveRegisterRange(uint16_t startAddr, uint16_t endAddr, Memor
 			_isWriteRegisterAddr[i] = false;
 		}
 	}
+	UpdateRegisterPages(startAddr, endAddr);
+}
+
+void BaseMapper::UpdateRegisterPages(uint16_t startAddr, uint16_t endAddr)
+{
+	for(int page = startAddr >> 8; page <= (endAddr >> 8); page++) {
+		bool hasReadRegister = false;
+		bool hasWriteRegister = false;
+		for(int i = page << 8, end = i + 0x100; i < end; i++) {
+			hasReadRegister |= _isReadRegisterAddr[i];
+			hasWriteRegister |= _isWriteRegisterAddr[i];
+		}
+		_isReadRegisterPage[page] = hasReadRegister;
+		_isWriteRegisterPage[page] = hasWriteRegister;
+		UpdateDirectPage((uint8_t)page);
+	}
 }
 
 void BaseMapper::Serialize(Serializer& s)
@@ -591,9 +617,13 @@ void BaseMapper::Initialize(NesConsole* console, RomData& romData)
 	}
 
 	_allowRegisterRead = AllowRegisterRead();
+	_allowDirectRead = !HasCustomReadRam();
+	_allowDirectWrite = !HasCustomWriteRam();
 
 	memset(_isReadRegisterAddr, 0, sizeof(_isReadRegisterAddr));
 	memset(_isWriteRegisterAddr, 0, sizeof(_isWriteRegisterAddr));
+	memset(_isReadRegisterPage, 0, sizeof(_isReadRegisterPage));
+	memset(_isWriteRegisterPage, 0, sizeof(_isWriteRegisterPage));
 	AddRegisterRange(RegisterStartAddress(), RegisterEndAddress(), MemoryOperation::Any);
 
 	_prgSize = (uint32_t)romData.PrgRom.size();
@@ -647,6 +677,8 @@ void BaseMapper::Initialize(NesConsole* console, RomData& romData)
 	for(int i = 0; i < 0x100; i++) {
 		//Allow us to map a different page every 256 bytes
 		_prgPages[i] = nullptr;
+		_prgReadPages[i] = nullptr;
+		_prgWritePages[i] = nullptr;
 		_prgMemoryOffset[i] = -1;
 		_prgMemoryType[i] = PrgMemoryType::PrgRom;
 		_prgMemoryAccess[i] = MemoryAccessType::NoAccess;
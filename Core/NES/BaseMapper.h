@@ -37,10 +37,22 @@ private:
 	bool _allowRegisterRead = false;
 	bool _isReadRegisterAddr[0x10000] = {};
 	bool _isWriteRegisterAddr[0x10000] = {};
+	bool _isReadRegisterPage[0x100] = {};
+	bool _isWriteRegisterPage[0x100] = {};
 
 	MemoryAccessType _prgMemoryAccess[0x100] = {};
 	uint8_t* _prgPages[0x100] = {};
 
+	//Same as _prgPages, but only set when ReadRam/WriteRam would access the page's memory directly (no registers, no custom ReadRam/WriteRam)
+	//Used by NesMemoryManager to bypass the ReadRam/WriteRam calls
+	bool _allowDirectRead = false;
+	bool _allowDirectWrite = false;
+	uint8_t* _prgReadPages[0x100] = {};
+	uint8_t* _prgWritePages[0x100] = {};
+
+	void UpdateRegisterPages(uint16_t startAddr, uint16_t endAddr);
+	void UpdateDirectPage(uint8_t page);
+
 	MemoryAccessType _chrMemoryAccess[0x100] = {};
 	uint8_t* _chrPages[0x100] = {};
 
@@ -105,6 +117,10 @@ protected:
 	
 	virtual bool HasBusConflicts() { return false; }
 
+	//Must return true when the mapper overrides ReadRam/WriteRam, to prevent direct access to the PRG pages
+	virtual bool HasCustomReadRam() { return false; }
+	virtual bool HasCustomWriteRam() { return false; }
+
 	uint8_t InternalReadRam(uint16_t addr);
 
 	virtual void WriteRegister(uint16_t addr, uint8_t value);
@@ -189,6 +205,9 @@ public:
 	void DebugWriteRam(uint16_t addr, uint8_t value);
 	void WritePrgRam(uint16_t addr, uint8_t value);
 
+	uint8_t** GetPrgReadPages() { return _prgReadPages; }
+	uint8_t** GetPrgWritePages() { return _prgWritePages; }
+
 	virtual uint8_t MapperReadVram(uint16_t addr, MemoryOperationType operationType);
 	
 	__forceinline uint8_t ReadVram(uint16_t addr, MemoryOperationType type = MemoryOperationType::PpuRenderingRead)
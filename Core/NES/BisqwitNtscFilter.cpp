@@ -12,8 +12,6 @@
 BisqwitNtscFilter::BisqwitNtscFilter(Emulator* emu) : BaseVideoFilter(emu)
 {
 	_resDivider = 1;
-	_stopThread = false;
-	_workDone = false;
 
 	// from https ://forums.nesdev.org/viewtopic.php?p=159266#p159266
 	const double signalLumaLow[2][4] = {
@@ -50,34 +48,6 @@ BisqwitNtscFilter::BisqwitNtscFilter(Emulator* emu) : BaseVideoFilter(emu)
 			_signalHigh[(h ? 0x40 : 0) | i] = int8_t(std::floor(((q - signal_blank) / (signal_white - signal_blank)) * 100));
 		}
 	}
-
-	_extraThread = std::thread([=]() {
-		//Worker thread to improve decode speed
-		while(!_stopThread) {
-			_waitWork.Wait();
-			if(_stopThread) {
-				break;
-			}
-
-			uint32_t* outputBuffer = GetOutputBuffer();
-			FrameInfo frameInfo = _frameInfo;
-
-			//Adjust outputbuffer to start at the middle of the picture
-			int scale = 8 / _resDivider;
-			outputBuffer += frameInfo.Width * ((120 - GetOverscan().Top) * scale);
-
-			DecodeFrame(120, 239 - GetOverscan().Bottom, _ppuOutputBuffer, outputBuffer, (GetVideoPhase() * 4) + 327360);
-
-			_workDone = true;
-		}
-	});
-}
-
-BisqwitNtscFilter::~BisqwitNtscFilter()
-{
-	_stopThread = true;
-	_waitWork.Signal();
-	_extraThread.join();
 }
 
 void BisqwitNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
@@ -88,10 +58,10 @@ void BisqwitNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		NesDefaultVideoFilter::ApplyPalBorder(ppuOutputBuffer);
 	}
 
-	_workDone = false;
-	_waitWork.Signal();
-	DecodeFrame(GetOverscan().Top, 120, ppuOutputBuffer, GetOutputBuffer(), (GetVideoPhase() * 4) + GetOverscan().Top*341*8);
-	while(!_workDone) {}
+	//All rows must be decoded before the missing lines between them can be generated
+	uint32_t rowCount = 240 - GetOverscan().Top - GetOverscan().Bottom;
+	GetWorkerPool()->RunRowBands(rowCount, [this](uint32_t firstRow, uint32_t endRow) { DecodeRows(firstRow, endRow); });
+	GetWorkerPool()->RunRowBands(rowCount, [this](uint32_t firstRow, uint32_t endRow) { BlendRows(firstRow, endRow); });
 }
 
 FrameInfo BisqwitNtscFilter::GetFrameInfo()
@@ -213,35 +183,43 @@ void BisqwitNtscFilter::GenerateNtscSignal(int8_t *ntscSignal, int &phase, int r
 	phase += (341 - 256) * _signalsPerPixel;
 }
 
-void BisqwitNtscFilter::DecodeFrame(int startRow, int endRow, uint16_t *ppuOutputBuffer, uint32_t* outputBuffer, int startPhase)
+void BisqwitNtscFilter::DecodeRows(uint32_t firstRow, uint32_t endRow)
 {
 	int pixelsPerCycle = 8 / _resDivider;
-	int phase = startPhase;
 	constexpr int lineWidth = 256;
 	int8_t rowSignal[lineWidth * _signalsPerPixel];
 	uint32_t rowPixelGap = _frameInfo.Width * pixelsPerCycle;
-	
-	uint32_t* orgBuffer = outputBuffer;
+	uint32_t* outputBuffer = GetOutputBuffer() + firstRow * rowPixelGap;
+
+	//Each scanline is 341 PPU cycles long, so the phase can be calculated for any row
+	int startRow = GetOverscan().Top + firstRow;
+	int phase = (GetVideoPhase() * 4) + startRow * 341 * 8;
 
-	for(int y = startRow; y <= endRow; y++) {
+	for(uint32_t i = firstRow; i < endRow; i++) {
 		int startCycle = phase % 12;
-		
+
 		//Convert the PPU's output to an NTSC signal
-		GenerateNtscSignal(rowSignal, phase, y);
+		GenerateNtscSignal(rowSignal, phase, GetOverscan().Top + i);
 
 		//Convert the NTSC signal to RGB
 		NtscDecodeLine(lineWidth * _signalsPerPixel, rowSignal, outputBuffer, (startCycle + 7) % 12);
 
 		outputBuffer += rowPixelGap;
 	}
+}
 
+void BisqwitNtscFilter::BlendRows(uint32_t firstRow, uint32_t endRow)
+{
 	//Generate the missing vertical lines
-	outputBuffer = orgBuffer;
-	int lastRow = 239 - GetOverscan().Bottom;
+	int pixelsPerCycle = 8 / _resDivider;
+	uint32_t rowPixelGap = _frameInfo.Width * pixelsPerCycle;
+	uint32_t* outputBuffer = GetOutputBuffer() + firstRow * rowPixelGap;
+	uint32_t lastRow = 239 - GetOverscan().Top - GetOverscan().Bottom;
 	bool verticalBlend = false; //_emu->GetSettings()->GetVideoConfig();
-	for(int y = startRow; y <= endRow; y++) {
+
+	for(uint32_t i = firstRow; i < endRow; i++) {
 		uint64_t* currentLine = (uint64_t*)outputBuffer;
-		uint64_t* nextLine = y == lastRow ? currentLine : (uint64_t*)(outputBuffer + rowPixelGap);
+		uint64_t* nextLine = i == lastRow ? currentLine : (uint64_t*)(outputBuffer + rowPixelGap);
 		uint64_t* buffer = (uint64_t*)(outputBuffer + rowPixelGap / 2);
 
 		RecursiveBlend(4 / _resDivider, buffer, currentLine, nextLine, pixelsPerCycle, verticalBlend);
@@ -30,7 +30,7 @@ RowDataType NesTraceLogger::GetFormatTagType(string& tag)
 	}
 }
 
-void NesTraceLogger::GetTraceRow(string &output, NesCpuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo)
+void NesTraceLogger::GetTraceRow(string &output, NesCpuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 {
 	constexpr char activeStatusLetters[8] = { 'N', 'V', '-', '-', 'D', 'I', 'Z', 'C' };
 	constexpr char inactiveStatusLetters[8] = { 'n', 'v', '-', '-', 'd', 'i', 'z', 'c' };
@@ -42,7 +42,7 @@ void NesTraceLogger::GetTraceRow(string &output, NesCpuState &cpuState, TraceLog
 			case RowDataType::Y: WriteIntValue(output, cpuState.Y, rowPart); break;
 			case RowDataType::SP: WriteIntValue(output, cpuState.SP, rowPart); break;
 			case RowDataType::PS: GetStatusFlag(activeStatusLetters, inactiveStatusLetters, output, cpuState.PS, rowPart); break;
-			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo); break;
+			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo, capturedAddress); break;
 		}
 	}
 }
@@ -23,9 +23,9 @@ protected:
 	void InternalSetStateFromInput() override
 	{
 		for(KeyMapping& keyMapping : _keyMappings) {
-			SetPressedState(Buttons::Fire, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));
+			SetPressedState(Buttons::Fire, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));
 		}
-		SetMovement(KeyManager::GetMouseMovement(_emu, _emu->GetSettings()->GetInputConfig().MouseSensitivity));
+		SetMovement(_emu->GetKeyManager()->GetMouseMovement(_emu->GetSettings()->GetInputConfig().MouseSensitivity));
 	}
 
 	void Serialize(Serializer& s) override
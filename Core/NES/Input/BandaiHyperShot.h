@@ -24,11 +24,11 @@ protected:
 	void InternalSetStateFromInput() override
 	{
 		NesController::InternalSetStateFromInput();
-		MousePosition pos = KeyManager::GetMousePosition();
+		MousePosition pos = _emu->GetKeyManager()->GetMousePosition();
 
 		for(KeyMapping& keyMapping : _keyMappings) {
-			SetPressedState(ZapperButtons::Fire, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));
-			if(KeyManager::IsKeyPressed(keyMapping.CustomKeys[1])) {
+			SetPressedState(ZapperButtons::Fire, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));
+			if(_emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[1])) {
 				pos.X = -1;
 				pos.Y = -1;
 			}
@@ -20,7 +20,7 @@ protected:
 	void InternalSetStateFromInput() override
 	{
 		NesController::InternalSetStateFromInput();
-		SetMovement(KeyManager::GetMouseMovement(_emu, _emu->GetSettings()->GetInputConfig().MouseSensitivity));
+		SetMovement(_emu->GetKeyManager()->GetMouseMovement(_emu->GetSettings()->GetInputConfig().MouseSensitivity));
 	}
 
 public:
@@ -22,10 +22,10 @@ protected:
 
 	void InternalSetStateFromInput() override
 	{
-		MousePosition pos = KeyManager::GetMousePosition();
+		MousePosition pos = _emu->GetKeyManager()->GetMousePosition();
 		for(KeyMapping& keyMapping : _keyMappings) {
-			SetPressedState(Buttons::Click, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));
-			SetPressedState(Buttons::Touch, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));			
+			SetPressedState(Buttons::Click, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));
+			SetPressedState(Buttons::Touch, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));			
 		}
 		SetPressedState(Buttons::Touch, pos.Y >= 48);
 		SetCoordinates(pos);
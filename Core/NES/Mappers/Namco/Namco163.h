@@ -56,6 +56,7 @@ protected:
 	uint16_t GetChrPageSize() override { return 0x400; }
 	uint32_t GetSaveRamPageSize() override { return 0x800; }
 	bool AllowRegisterRead() override { return true; }
+	bool HasCustomWriteRam() override { return true; }
 	
 	void InitMapper() override
 	{
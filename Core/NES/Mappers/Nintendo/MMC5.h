@@ -350,6 +350,7 @@ protected:
 	}
 
 	bool AllowRegisterRead() override { return true; }
+	bool HasCustomWriteRam() override { return true; }
 
 	void InitMapper() override
 	{
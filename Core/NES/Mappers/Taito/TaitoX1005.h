@@ -22,6 +22,7 @@ protected:
 	uint32_t GetWorkRamSize() override { return 0x100; }
 	uint32_t GetWorkRamPageSize() override { return 0x100; }
 	uint32_t GetSaveRamSize() override { return 0x100; }
+	bool HasCustomWriteRam() override { return true; }
 	uint32_t GetSaveRamPageSize() override { return 0x100; }
 
 	bool ForceSaveRamSize() override { return HasBattery(); }
@@ -257,11 +257,12 @@ void NesConsole::RunFrame()
 		_nextFrameOverclockDisabled = false;
 	}
 
-	while(frame == _ppu->GetFrameCount()) {
-		_cpu->Exec();
-		if(_vsSubConsole) {
-			RunVsSubConsole();
-		}
+	//The instantiation is picked once per frame, like on the GBA (the debugger is attached between frames,
+	//and the <true> instantiation still checks for it at runtime if it is detached mid-frame)
+	if(_emu->IsDebugging()) {
+		RunCpu<true>(frame);
+	} else {
+		RunCpu<false>(frame);
 	}
 
 	_apu->EndFrame();
@@ -272,6 +273,18 @@ void NesConsole::RunFrame()
 	}
 }
 
+template<bool debuggerEnabled>
+void NesConsole::RunCpu(uint32_t frame)
+{
+	while(frame == _ppu->GetFrameCount()) {
+		_cpu->Exec<debuggerEnabled>();
+		if(_vsSubConsole) {
+			RunVsSubConsole<debuggerEnabled>();
+		}
+	}
+}
+
+template<bool debuggerEnabled>
 void NesConsole::RunVsSubConsole()
 {
 	int64_t cycleGap;
@@ -279,7 +292,7 @@ void NesConsole::RunVsSubConsole()
 		//Run the sub console until it catches up to the main CPU
 		cycleGap = (int64_t)(_cpu->GetCycleCount() - _vsSubConsole->_cpu->GetCycleCount());
 		if(cycleGap > 5 || _ppu->GetFrameCount() > _vsSubConsole->_ppu->GetFrameCount()) {
-			_vsSubConsole->_cpu->Exec();
+			_vsSubConsole->_cpu->Exec<debuggerEnabled>();
 		} else {
 			break;
 		}
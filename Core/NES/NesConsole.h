@@ -53,6 +53,8 @@ private:
 	bool _nextFrameOverclockDisabled = false;
 	
 	void UpdateRegion(bool forceUpdate = false);
+
+	template<bool debuggerEnabled> void RunCpu(uint32_t frame);
 	void LoadHdPack(VirtualFile& romFile);
 	
 	void InitializeInputDevices(GameInputType inputType, GameSystem system);
@@ -81,7 +83,7 @@ public:
 	NesConsole* GetVsMainConsole();
 	NesConsole* GetVsSubConsole();
 	bool IsVsMainConsole();
-	void RunVsSubConsole();
+	template<bool debuggerEnabled> void RunVsSubConsole();
 
 	void SetNextFrameOverclockStatus(bool disabled);
 
@@ -163,10 +163,13 @@ void NesCpu::Reset(bool softReset, ConsoleRegion region)
 	}
 }
 
+template<bool debuggerEnabled>
 void NesCpu::Exec()
 {
 #ifndef DUMMYCPU
-	_emu->ProcessInstruction<CpuType::Nes>();
+	if constexpr(debuggerEnabled) {
+		_emu->ProcessInstruction<CpuType::Nes>();
+	}
 #endif
 
 	uint8_t opCode = GetOPCode();
@@ -179,6 +182,9 @@ void NesCpu::Exec()
 	}
 }
 
+template void NesCpu::Exec<false>();
+template void NesCpu::Exec<true>();
+
 void NesCpu::IRQ() 
 {
 #ifndef DUMMYCPU
@@ -793,7 +793,10 @@ public:
 	bool IsDmcDma() { return _isDmcDmaRead; }
 
 	void Reset(bool softReset, ConsoleRegion region);
-	void Exec();
+
+	//The instruction/halted cpu debugger hooks are only compiled into the <true> instantiation
+	//(memory and PPU hooks are shared by both and still check for the debugger at runtime, as on the GBA)
+	template<bool debuggerEnabled = true> void Exec();
 
 	NesCpuState& GetState()
 	{ 
@@ -36,6 +36,10 @@ NesMemoryManager::NesMemoryManager(NesConsole* console, BaseMapper* mapper)
 		_ramWriteHandlers[i] = &_openBusHandler;
 	}
 
+	for(int i = 0; i < 0x20; i++) {
+		_internalRamPages[i] = _internalRam + ((i << 8) & (_internalRamSize - 1));
+	}
+
 	RegisterIODevice(_internalRamHandler.get());	
 }
 
@@ -73,6 +77,7 @@ void NesMemoryManager::RegisterIODevice(INesMemoryHandler*handler)
 
 	InitializeMemoryHandlers(_ramReadHandlers, handler, ranges.GetRAMReadAddresses(), ranges.GetAllowOverride());
 	InitializeMemoryHandlers(_ramWriteHandlers, handler, ranges.GetRAMWriteAddresses(), ranges.GetAllowOverride());
+	UpdateDirectPages();
 }
 
 void NesMemoryManager::RegisterWriteHandler(INesMemoryHandler* handler, uint32_t start, uint32_t end)
@@ -80,6 +85,7 @@ void NesMemoryManager::RegisterWriteHandler(INesMemoryHandler* handler, uint32_t
 	for(uint32_t i = start; i < end; i++) {
 		_ramWriteHandlers[i] = handler;
 	}
+	UpdateDirectPages();
 }
 
 void NesMemoryManager::UnregisterIODevice(INesMemoryHandler*handler)
@@ -94,6 +100,35 @@ void NesMemoryManager::UnregisterIODevice(INesMemoryHandler*handler)
 	for(uint16_t address : *ranges.GetRAMWriteAddresses()) {
 		_ramWriteHandlers[address] = &_openBusHandler;
 	}
+	UpdateDirectPages();
+}
+
+void NesMemoryManager::UpdateDirectPages()
+{
+	uint8_t** mapperReadPages = _mapper->GetPrgReadPages();
+	uint8_t** mapperWritePages = _mapper->GetPrgWritePages();
+	for(int i = 0; i < 0x100; i++) {
+		_readPages[i] = GetDirectPage(_ramReadHandlers, i, mapperReadPages);
+		_writePages[i] = GetDirectPage(_ramWriteHandlers, i, mapperWritePages);
+	}
+}
+
+uint8_t** NesMemoryManager::GetDirectPage(INesMemoryHandler** memoryHandlers, uint16_t page, uint8_t** mapperPages)
+{
+	//Only internal RAM and the mapper's PRG pages can be accessed directly, and only if the whole page uses the same handler
+	INesMemoryHandler* handler = memoryHandlers[page << 8];
+	for(int i = 1; i < 0x100; i++) {
+		if(memoryHandlers[(page << 8) | i] != handler) {
+			return &_noDirectPage;
+		}
+	}
+
+	if(handler == _internalRamHandler.get() && page < 0x20) {
+		return &_internalRamPages[page];
+	} else if(handler == _mapper) {
+		return &mapperPages[page];
+	}
+	return &_noDirectPage;
 }
 
 uint8_t* NesMemoryManager::GetInternalRam()
@@ -117,7 +152,13 @@ uint16_t NesMemoryManager::DebugReadWord(uint16_t addr)
 
 uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 {
-	uint8_t value = _ramReadHandlers[addr]->ReadRam(addr);
+	uint8_t value;
+	uint8_t* page = *_readPages[addr >> 8];
+	if(page) {
+		value = page[(uint8_t)addr];
+	} else {
+		value = _ramReadHandlers[addr]->ReadRam(addr);
+	}
 	if(_cheatManager->HasCheats<CpuType::Nes>()) {
 		_cheatManager->ApplyCheat<CpuType::Nes>(addr, value);
 	}
@@ -131,7 +172,12 @@ uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 void NesMemoryManager::Write(uint16_t addr, uint8_t value, MemoryOperationType operationType)
 {
 	if(_emu->ProcessMemoryWrite<CpuType::Nes>(addr, value, operationType)) {
-		_ramWriteHandlers[addr]->WriteRam(addr, value);
+		uint8_t* page = *_writePages[addr >> 8];
+		if(page) {
+			page[(uint8_t)addr] = value;
+		} else {
+			_ramWriteHandlers[addr]->WriteRam(addr, value);
+		}
 		_openBusHandler.SetOpenBus(value);
 	}
 }
@@ -33,7 +33,16 @@ private:
 	INesMemoryHandler** _ramReadHandlers = nullptr;
 	INesMemoryHandler** _ramWriteHandlers = nullptr;
 
+	//For each 256-byte page, points to the entry (in _internalRamPages or the mapper's PRG page tables) that contains
+	//the page's memory, when the page can be accessed without calling its handler - otherwise points to _noDirectPage (nullptr)
+	uint8_t** _readPages[0x100] = {};
+	uint8_t** _writePages[0x100] = {};
+	uint8_t* _internalRamPages[0x20] = {};
+	uint8_t* _noDirectPage = nullptr;
+
 	void InitializeMemoryHandlers(INesMemoryHandler** memoryHandlers, INesMemoryHandler* handler, vector<uint16_t>* addresses, bool allowOverride);
+	void UpdateDirectPages();
+	uint8_t** GetDirectPage(INesMemoryHandler** memoryHandlers, uint16_t page, uint8_t** mapperPages);
 
 protected:
 	void Serialize(Serializer& s) override;
@@ -80,7 +80,12 @@ void NesNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		NesDefaultVideoFilter::ApplyPalBorder(ppuOutputBuffer);
 	}
 
-	nes_ntsc_blit(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, GetVideoPhase(), _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, NES_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+	//The burst phase moves forward by 1 on each row, so each band starts at the phase the serial blit would be at
+	uint32_t width = _baseFrameInfo.Width;
+	int phase = GetVideoPhase();
+	GetWorkerPool()->RunRowBands(_baseFrameInfo.Height, [=](uint32_t firstRow, uint32_t endRow) {
+		nes_ntsc_blit(&_ntscData, ppuOutputBuffer + firstRow * width, width, (phase + firstRow) % nes_ntsc_burst_count, width, endRow - firstRow, _ntscBuffer + firstRow * baseWidth, baseWidth * 4);
+	});
 
 	for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
 		memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + (i/2)*baseWidth, frameInfo.Width * sizeof(uint32_t));
@@ -10,10 +10,13 @@ public:
 	string Password;
 	bool Spectator = false;
 
+	//0 = delay-based netplay (wait for the server's input before running each frame)
+	uint32_t MaxRollbackFrames = 0;
+
 	ClientConnectionData() {}
 
-	ClientConnectionData(string host, uint16_t port, string password, bool spectator) :
-		Host(host), Port(port), Password(password), Spectator(spectator)
+	ClientConnectionData(string host, uint16_t port, string password, bool spectator, uint32_t maxRollbackFrames) :
+		Host(host), Port(port), Password(password), Spectator(spectator), MaxRollbackFrames(maxRollbackFrames)
 	{
 	}
 
@@ -23,12 +23,44 @@ bool GameClient::Connected()
 	return _connected;
 }
 
+shared_ptr<GameClientConnection> GameClient::GetConnection()
+{
+	auto lock = _connectionLock.AcquireSafe();
+	return _connection;
+}
+
+bool GameClient::IsRollbackEnabled()
+{
+	if(!_connected) {
+		return false;
+	}
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	return connection && connection->IsRollbackEnabled();
+}
+
+void GameClient::ProcessRollback()
+{
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	if(connection) {
+		connection->ProcessRollback();
+	}
+}
+
+uint32_t GameClient::GetRollbackCount()
+{
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	return connection ? connection->GetRollbackCount() : 0;
+}
+
 void GameClient::Connect(ClientConnectionData &connectionData)
 {
 	_stop = false;
 	unique_ptr<Socket> socket(new Socket());
 	if(socket->Connect(connectionData.Host.c_str(), connectionData.Port)) {
-		_connection.reset(new GameClientConnection(_emu, std::move(socket), connectionData));
+		{
+			auto lock = _connectionLock.AcquireSafe();
+			_connection.reset(new GameClientConnection(_emu, std::move(socket), connectionData));
+		}
 		_connected = true;
 		_clientThread.reset(new thread(&GameClient::Exec, this));
 		_emu->GetNotificationManager()->RegisterNotificationListener(shared_from_this());
@@ -50,18 +82,19 @@ void GameClient::Disconnect()
 
 void GameClient::Exec()
 {
-	if(_connected) {
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	if(_connected && connection) {
 		while(!_stop) {
-			if(!_connection->ConnectionError()) {
-				_connection->ProcessMessages();
-				_connection->SendInput();
+			if(!connection->ConnectionError()) {
+				connection->ProcessMessages();
+				connection->SendInput();
 			} else {
 				break;
 			}
 			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
 		}
 		_connected = false;
-		_connection->Shutdown();
+		connection->Shutdown();
 	}
 }
 
@@ -80,24 +113,28 @@ void GameClient::ProcessNotification(ConsoleNotificationType type, void* paramet
 		Disconnect();
 	}
 	
-	if(_connection) {
-		_connection->ProcessNotification(type, parameter);
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	if(connection) {
+		connection->ProcessNotification(type, parameter);
 	}
 }
 
 void GameClient::SelectController(NetplayControllerInfo controller)
 {
-	if(_connection) {
-		_connection->SelectController(controller);
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	if(connection) {
+		connection->SelectController(controller);
 	}
 }
 
 vector<NetplayControllerUsageInfo> GameClient::GetControllerList()
 {
-	return _connection ? _connection->GetControllerList() : vector<NetplayControllerUsageInfo>();
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	return connection ? connection->GetControllerList() : vector<NetplayControllerUsageInfo>();
 }
 
 NetplayControllerInfo GameClient::GetControllerPort()
 {
-	return _connection ? _connection->GetControllerPort() : NetplayControllerInfo { GameConnection::SpectatorPort, 0 };
+	shared_ptr<GameClientConnection> connection = GetConnection();
+	return connection ? connection->GetControllerPort() : NetplayControllerInfo { GameConnection::SpectatorPort, 0 };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Shared/Interfaces/INotificationListener.h"
 #include "Netplay/NetplayTypes.h"
+#include "Utilities/SimpleLock.h"
 
 class Socket;
 class GameClientConnection;
@@ -13,18 +14,25 @@ class GameClient : public INotificationListener, public std::enable_shared_from_
 private:
 	Emulator* _emu;
 	unique_ptr<thread> _clientThread;
-	unique_ptr<GameClientConnection> _connection;
+	shared_ptr<GameClientConnection> _connection;
+	SimpleLock _connectionLock;
 
 	atomic<bool> _stop;
 	atomic<bool> _connected;
 
 	void Exec();
 
+	//Used by the emulation/UI threads - the connection is replaced by Connect() while they may be using it
+	shared_ptr<GameClientConnection> GetConnection();
+
 public:
 	GameClient(Emulator* emu);
 	virtual ~GameClient();
 
 	bool Connected();
+	bool IsRollbackEnabled();
+	void ProcessRollback();
+	uint32_t GetRollbackCount();
 	void Connect(ClientConnectionData &connectionData);
 	void Disconnect();
 
@@ -25,6 +25,19 @@ GameClientConnection::GameClientConnection(Emulator* emu, unique_ptr<Socket> soc
 	_minimumQueueSize = 3;
 	_controllerType = ControllerType::None;
 
+	_maxRollbackFrames = connectionData.MaxRollbackFrames;
+	_resetRollback = true;
+	_rollbackCount = 0;
+	if(_maxRollbackFrames > 0) {
+		//The emulation can only get _maxRollbackFrames ahead of the server's input, so the oldest
+		//frame that may need to be emulated again is always one of the last _maxRollbackFrames+1 frames
+		_snapshots.resize(_maxRollbackFrames + 1);
+		_snapshotFrames.resize(_maxRollbackFrames + 1, InvalidSnapshotFrame);
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			_frameInput[i].resize(_maxRollbackFrames + 1);
+		}
+	}
+
 	MessageManager::DisplayMessage("NetPlay", "ConnectedToServer");
 }
 
@@ -42,6 +55,9 @@ void GameClientConnection::Shutdown()
 		_emu->UnregisterInputProvider(this);
 
 		MessageManager::DisplayMessage("NetPlay", "ConnectionLost");
+		if(_maxRollbackFrames > 0) {
+			MessageManager::Log("[Netplay] " + std::to_string(_rollbackCount) + " rollbacks, " + std::to_string(_rollbackFrameCount) + " frames emulated again");
+		}
 		_emu->GetSettings()->ClearFlag(EmulationFlags::MaximumSpeed);
 	}
 	Disconnect();
@@ -66,6 +82,9 @@ void GameClientConnection::ClearInputData()
 		_inputSize[i] = 0;
 		_inputData[i].clear();
 	}
+
+	//The next frame matches the server's next input (e.g after loading the server's state)
+	_resetRollback = true;
 }
 
 void GameClientConnection::ProcessMessage(NetMessage* message)
@@ -154,7 +173,7 @@ void GameClientConnection::PushControllerState(uint8_t port, ControlDeviceState
 	_inputData[port].push_back(state);
 	_inputSize[port]++;
 
-	if(_inputData[port].size() >= _minimumQueueSize) {
+	if(_maxRollbackFrames > 0 || _inputData[port].size() >= _minimumQueueSize) {
 		_waitForInput[port].Signal();
 	}
 }
@@ -172,6 +191,11 @@ void GameClientConnection::DisableControllers()
 bool GameClientConnection::SetInput(BaseControlDevice *device)
 {
 	if(_enableControllers) {
+		if(_maxRollbackFrames > 0) {
+			SetRollbackInput(device);
+			return true;
+		}
+
 		uint8_t port = device->GetPort();
 		while(_inputSize[port] == 0) {
 			_waitForInput[port].Wait();
@@ -207,6 +231,146 @@ bool GameClientConnection::SetInput(BaseControlDevice *device)
 	return true;
 }
 
+void GameClientConnection::SetRollbackInput(BaseControlDevice* device)
+{
+	uint8_t port = device->GetPort();
+	_activePorts |= 1 << port;
+
+	ControlDeviceState& state = _frameInput[port][_currentFrame % _frameInput[port].size()];
+	if(_currentFrame >= _confirmedFrames[port]) {
+		LockHandler lock = _writeLock.AcquireSafe();
+		if(_currentFrame == _confirmedFrames[port] && !_inputData[port].empty()) {
+			//The server's input for this frame was already received
+			state = _inputData[port].front();
+			_inputData[port].pop_front();
+			_inputSize[port]--;
+			_lastConfirmedInput[port] = state;
+			_confirmedFrames[port]++;
+		} else {
+			//Predict that the player is still pressing the same buttons
+			state = _lastConfirmedInput[port];
+		}
+	}
+
+	device->SetRawState(state);
+}
+
+void GameClientConnection::ProcessRollback()
+{
+	//Called by the emulation thread before each frame (the emulator mutes audio/video while this runs)
+	uint32_t ringSize = (uint32_t)_snapshots.size();
+
+	if(_resetRollback) {
+		_resetRollback = false;
+		_frameCount = 0;
+		_currentFrame = 0;
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			_confirmedFrames[i] = 0;
+			_lastConfirmedInput[i] = {};
+		}
+
+		//The frame numbers restart at 0, the snapshots taken before this point can't be used anymore
+		std::fill(_snapshotFrames.begin(), _snapshotFrames.end(), InvalidSnapshotFrame);
+	}
+
+	for(int port = 0; port < BaseControlDevice::PortCount; port++) {
+		if(_activePorts & (1 << port)) {
+			//Wait for the server when the emulation is too far ahead of its input to be able to roll back
+			while(true) {
+				uint32_t receivedFrames;
+				{
+					LockHandler lock = _writeLock.AcquireSafe();
+					receivedFrames = _confirmedFrames[port] + _inputSize[port];
+				}
+
+				if(_frameCount < receivedFrames + _maxRollbackFrames) {
+					break;
+				}
+
+				_waitForInput[port].Wait();
+				if(_shutdown || !_enableControllers || _resetRollback) {
+					return;
+				}
+			}
+		}
+	}
+
+	//Compare the input received from the server with the predictions used for the frames that already ran
+	uint32_t mispredictedFrame = _frameCount;
+	bool needSnapshot = _activePorts == 0;
+	bool catchUp = false;
+	{
+		LockHandler lock = _writeLock.AcquireSafe();
+		for(int port = 0; port < BaseControlDevice::PortCount; port++) {
+			bool isActive = (_activePorts & (1 << port)) != 0;
+			while(_confirmedFrames[port] < _frameCount && !_inputData[port].empty()) {
+				uint32_t frame = _confirmedFrames[port]++;
+				ControlDeviceState& state = _frameInput[port][frame % ringSize];
+				if(isActive && state != _inputData[port].front()) {
+					mispredictedFrame = std::min(mispredictedFrame, frame);
+				}
+				state = _inputData[port].front();
+				_lastConfirmedInput[port] = state;
+				_inputData[port].pop_front();
+				_inputSize[port]--;
+			}
+
+			if(isActive && _inputData[port].empty()) {
+				//The next frame's input will be predicted, a snapshot is needed to be able to roll it back
+				needSnapshot = true;
+			}
+
+			if(isActive && _inputSize[port] > _minimumQueueSize) {
+				//The server is ahead, catch up
+				catchUp = true;
+			}
+		}
+	}
+
+	if(mispredictedFrame < _frameCount) {
+		//Restore the state from before the first mispredicted frame, and emulate the frames again with the correct input
+		_rollbackCount++;
+		_rollbackFrameCount += _frameCount - mispredictedFrame;
+
+		shared_ptr<IConsole> console = _emu->GetConsole();
+		uint32_t slot = mispredictedFrame % ringSize;
+		if(_snapshotFrames[slot] != mispredictedFrame) {
+			//The slot doesn't hold the snapshot for this frame (it was never taken, or was overwritten by a later frame)
+			MessageManager::Log("[Netplay] Could not roll back to frame " + std::to_string(mispredictedFrame) + " (no snapshot for this frame)");
+		} else if(_emu->LoadSnapshot(_snapshots[slot], false)) {
+			for(uint32_t frame = mispredictedFrame; frame < _frameCount; frame++) {
+				if(frame > mispredictedFrame) {
+					SaveRollbackSnapshot(frame);
+				}
+				_currentFrame = frame;
+				console->RunFrame();
+			}
+		} else {
+			//The layout changed since the snapshot was taken (the current state was restored), the mispredicted frames are kept as-is
+			MessageManager::Log("[Netplay] Could not roll back to frame " + std::to_string(mispredictedFrame));
+		}
+	}
+
+	if(catchUp) {
+		_emu->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
+	} else {
+		_emu->GetSettings()->ClearFlag(EmulationFlags::MaximumSpeed);
+	}
+
+	if(needSnapshot) {
+		SaveRollbackSnapshot(_frameCount);
+	}
+	_currentFrame = _frameCount;
+	_frameCount++;
+}
+
+void GameClientConnection::SaveRollbackSnapshot(uint32_t frame)
+{
+	uint32_t slot = frame % _snapshots.size();
+	_emu->SaveSnapshot(_snapshots[slot], false);
+	_snapshotFrames[slot] = frame;
+}
+
 void GameClientConnection::InitControlDevice()
 {
 	shared_ptr<IConsole> console = _emu->GetConsole();
@@ -7,6 +7,7 @@
 #include "Shared/Interfaces/INotificationListener.h"
 #include "Shared/Interfaces/IInputProvider.h"
 #include "Shared/ControlDeviceState.h"
+#include "Shared/StateSnapshot.h"
 #include "Netplay/GameConnection.h"
 #include "Netplay/ClientConnectionData.h"
 #include "Netplay/NetplayTypes.h"
@@ -34,12 +35,33 @@ private:
 	ClientConnectionData _connectionData = {};
 	string _serverSalt;
 
+	//Rollback mode (MaxRollbackFrames > 0): frames are emulated without waiting for the server's input.
+	//Missing input is predicted and, once the server's input is received, the frames that used
+	//the wrong input are emulated again from the snapshot taken before them
+	static constexpr uint32_t InvalidSnapshotFrame = UINT32_MAX;
+
+	uint32_t _maxRollbackFrames = 0;
+	vector<StateSnapshot> _snapshots;
+	//Frame number of the snapshot held by each slot of _snapshots
+	vector<uint32_t> _snapshotFrames;
+	vector<ControlDeviceState> _frameInput[BaseControlDevice::PortCount];
+	ControlDeviceState _lastConfirmedInput[BaseControlDevice::PortCount] = {};
+	uint32_t _confirmedFrames[BaseControlDevice::PortCount] = {};
+	uint32_t _activePorts = 0;
+	uint32_t _frameCount = 0;
+	uint32_t _currentFrame = 0;
+	atomic<bool> _resetRollback;
+	atomic<uint32_t> _rollbackCount;
+	uint32_t _rollbackFrameCount = 0;
+
 private:
 	void SendHandshake();
 	void SendControllerSelection(NetplayControllerInfo controller);
 	void ClearInputData();
 	void PushControllerState(uint8_t port, ControlDeviceState state);
 	void DisableControllers();
+	void SetRollbackInput(BaseControlDevice* device);
+	void SaveRollbackSnapshot(uint32_t frame);
 	bool AttemptLoadGame(string filename, uint32_t crc32);
 
 protected:
@@ -54,6 +76,9 @@ public:
 	void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
 
 	bool SetInput(BaseControlDevice *device) override;
+	bool IsRollbackEnabled() { return _maxRollbackFrames > 0 && _enableControllers; }
+	void ProcessRollback();
+	uint32_t GetRollbackCount() { return _rollbackCount; }
 	void InitControlDevice();
 	void SendInput();
 
@@ -30,7 +30,7 @@ RowDataType PceTraceLogger::GetFormatTagType(string& tag)
 	}
 }
 
-void PceTraceLogger::GetTraceRow(string &output, PceCpuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo)
+void PceTraceLogger::GetTraceRow(string &output, PceCpuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 {
 	constexpr char activeStatusLetters[8] = { 'N', 'V', '-', 'T', 'D', 'I', 'Z', 'C' };
 	constexpr char inactiveStatusLetters[8] = { 'n', 'v', '-', 't', 'd', 'i', 'z', 'c' };
@@ -42,7 +42,7 @@ void PceTraceLogger::GetTraceRow(string &output, PceCpuState &cpuState, TraceLog
 			case RowDataType::Y: WriteIntValue(output, cpuState.Y, rowPart); break;
 			case RowDataType::SP: WriteIntValue(output, cpuState.SP, rowPart); break;
 			case RowDataType::PS: GetStatusFlag(activeStatusLetters, inactiveStatusLetters, output, cpuState.PS, rowPart); break;
-			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo); break;
+			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo, capturedAddress); break;
 		}
 	}
 }
@@ -18,7 +18,7 @@ protected:
 public:
 	PceTraceLogger(Debugger* debugger, IDebugger* cpuDebugger, PceVdc* vdc);
 	
-	void GetTraceRow(string& output, PceCpuState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo);
+	void GetTraceRow(string& output, PceCpuState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress);
 	void LogPpuState();
 
 	__forceinline uint32_t GetProgramCounter(PceCpuState& state) { return state.PC; }
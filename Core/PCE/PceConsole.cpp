@@ -155,14 +155,26 @@ bool PceConsole::IsSuperGrafxCard(uint32_t crc32)
 void PceConsole::RunFrame()
 {
 	uint32_t frameCount = _vdc->GetFrameCount();
-	while(frameCount == _vdc->GetFrameCount()) {
-		_cpu->Exec();
+	//The instantiation is picked once per frame, like on the GBA (the debugger is attached between frames,
+	//and the <true> instantiation still checks for it at runtime if it is detached mid-frame)
+	if(_emu->IsDebugging()) {
+		RunCpu<true>(frameCount);
+	} else {
+		RunCpu<false>(frameCount);
 	}
 	
 	_psg->Run();
 	_psg->PlayQueuedAudio();
 }
 
+template<bool debuggerEnabled>
+void PceConsole::RunCpu(uint32_t frameCount)
+{
+	while(frameCount == _vdc->GetFrameCount()) {
+		_cpu->Exec<debuggerEnabled>();
+	}
+}
+
 void PceConsole::SaveBattery()
 {
 	if(_cdrom) {
@@ -43,6 +43,8 @@ private:
 	bool LoadHesFile(VirtualFile& hesFile);
 	bool LoadFirmware(DiscInfo& disc, vector<uint8_t>& romData);
 
+	template<bool debuggerEnabled> void RunCpu(uint32_t frameCount);
+
 public:
 	PceConsole(Emulator* emu);
 	
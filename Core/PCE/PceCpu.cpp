@@ -91,10 +91,13 @@ PceCpu::PceCpu(Emulator* emu, PceMemoryManager* memoryManager)
 }
 #endif
 
+template<bool debuggerEnabled>
 void PceCpu::Exec()
 {
 #ifndef DUMMYCPU
-	_emu->ProcessInstruction<CpuType::Pce>();
+	if constexpr(debuggerEnabled) {
+		_emu->ProcessInstruction<CpuType::Pce>();
+	}
 #endif
 
 	//T flag is reset at the start of each instruction
@@ -111,6 +114,9 @@ void PceCpu::Exec()
 	}
 }
 
+template void PceCpu::Exec<false>();
+template void PceCpu::Exec<true>();
+
 void PceCpu::FetchOperand()
 {
 	switch(_instAddrMode) {
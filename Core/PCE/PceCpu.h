@@ -299,7 +299,9 @@ public:
 	
 	void RunIdleCpuCycle();
 
-	void Exec();
+	//The instruction/halted cpu debugger hooks are only compiled into the <true> instantiation
+	//(memory and PPU hooks are shared by both and still check for the debugger at runtime, as on the GBA)
+	template<bool debuggerEnabled = true> void Exec();
 
 	void Serialize(Serializer& s) override;
 
@@ -79,37 +79,44 @@ void PceNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		return;
 	}
 
-	//Convert RGB333 to RGB555 since this is what blargg's SNES NTSC filter expects
-	for(uint32_t i = 0; i < rowCount; i++) {
-		uint8_t clockDivider = _frameDivider ? _frameDivider : ppuOutputBuffer[clockDividerOffset + i + overscan.Top];
-		uint32_t xOffset = PceConstants::GetLeftOverscan(clockDivider) + (overscan.Left * 4 / (clockDivider ? clockDivider : 4));
-		uint32_t rowWidth = PceConstants::GetRowWidth(clockDivider);
-
-		double ratio = _frameDivider ? 1.0 : ((double)rowWidth / baseFrameInfo.Width);
-		uint32_t baseOffset = i * frameWidth;
-		for(uint32_t j = 0; j < frameWidth; j++) {
-			int pos = (int)(j * ratio);
-			uint32_t color = _pceConfig.Palette[ppuOutputBuffer[i * PceConstants::MaxScreenWidth + pos + yOffset + xOffset] & 0x1FF];
-
-			uint8_t r = (color >> 19) & 0x1F;
-			uint8_t g = (color >> 11) & 0x1F;
-			uint8_t b = (color >> 3) & 0x1F;
-
-			_rgb555Buffer[baseOffset + j] = (b << 10) | (g << 5) | r;
+	//Each band of rows is converted, blitted and copied to the output independently
+	//The burst phase moves forward by 1 on each row, so each band starts at the phase the serial blit would be at
+	int phase = IsOddFrame() ? 0 : 1;
+	GetWorkerPool()->RunRowBands(rowCount, [=](uint32_t firstRow, uint32_t endRow) {
+		//Convert RGB333 to RGB555 since this is what blargg's SNES NTSC filter expects
+		for(uint32_t i = firstRow; i < endRow; i++) {
+			uint8_t clockDivider = _frameDivider ? _frameDivider : ppuOutputBuffer[clockDividerOffset + i + overscan.Top];
+			uint32_t xOffset = PceConstants::GetLeftOverscan(clockDivider) + (overscan.Left * 4 / (clockDivider ? clockDivider : 4));
+			uint32_t rowWidth = PceConstants::GetRowWidth(clockDivider);
+
+			double ratio = _frameDivider ? 1.0 : ((double)rowWidth / baseFrameInfo.Width);
+			uint32_t baseOffset = i * frameWidth;
+			for(uint32_t j = 0; j < frameWidth; j++) {
+				int pos = (int)(j * ratio);
+				uint32_t color = _pceConfig.Palette[ppuOutputBuffer[i * PceConstants::MaxScreenWidth + pos + yOffset + xOffset] & 0x1FF];
+
+				uint8_t r = (color >> 19) & 0x1F;
+				uint8_t g = (color >> 11) & 0x1F;
+				uint8_t b = (color >> 3) & 0x1F;
+
+				_rgb555Buffer[baseOffset + j] = (b << 10) | (g << 5) | r;
+			}
 		}
-	}
 
-	if(_frameDivider) {
-		snes_ntsc_blit(&_ntscData, _rgb555Buffer, frameWidth, IsOddFrame() ? 0 : 1, frameWidth, rowCount, GetOutputBuffer(), frameInfo.Width * sizeof(uint32_t));
-	} else {
-		snes_ntsc_blit_hires(&_ntscData, _rgb555Buffer, frameWidth, IsOddFrame() ? 0 : 1, frameWidth, rowCount, _ntscBuffer, frameInfo.Width * sizeof(uint32_t));
-
-		for(uint32_t i = 0; i < rowCount; i++) {
-			uint32_t* src = _ntscBuffer + i * frameInfo.Width;
-			for(uint32_t j = 0; j < verticalScale; j++) {
-				uint32_t* dst = GetOutputBuffer() + (i * verticalScale + j) * frameInfo.Width;
-				memcpy(dst, src, frameInfo.Width * sizeof(uint32_t));
+		uint16_t* in = _rgb555Buffer + firstRow * frameWidth;
+		int burstPhase = (phase + firstRow) % snes_ntsc_burst_count;
+		if(_frameDivider) {
+			snes_ntsc_blit(&_ntscData, in, frameWidth, burstPhase, frameWidth, endRow - firstRow, GetOutputBuffer() + firstRow * frameInfo.Width, frameInfo.Width * sizeof(uint32_t));
+		} else {
+			snes_ntsc_blit_hires(&_ntscData, in, frameWidth, burstPhase, frameWidth, endRow - firstRow, _ntscBuffer + firstRow * frameInfo.Width, frameInfo.Width * sizeof(uint32_t));
+
+			for(uint32_t i = firstRow; i < endRow; i++) {
+				uint32_t* src = _ntscBuffer + i * frameInfo.Width;
+				for(uint32_t j = 0; j < verticalScale; j++) {
+					uint32_t* dst = GetOutputBuffer() + (i * verticalScale + j) * frameInfo.Width;
+					memcpy(dst, src, frameInfo.Width * sizeof(uint32_t));
+				}
 			}
 		}
-	}
+	});
 }
@@ -63,7 +63,7 @@ RowDataType SmsTraceLogger::GetFormatTagType(string& tag)
 	}
 }
 
-void SmsTraceLogger::GetTraceRow(string &output, SmsCpuState &cpuState, TraceLogPpuState &vdpState, DisassemblyInfo &disassemblyInfo)
+void SmsTraceLogger::GetTraceRow(string &output, SmsCpuState &cpuState, TraceLogPpuState &vdpState, DisassemblyInfo &disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 {
 	constexpr char activeStatusLetters[8] = { 'S', 'Z', '5', 'H', '3', 'P', 'N', 'C' };
 	constexpr char inactiveStatusLetters[8] = { 's', 'z', '-', 'h', '-', 'p', 'n', 'c' };
@@ -92,7 +92,7 @@ void SmsTraceLogger::GetTraceRow(string &output, SmsCpuState &cpuState, TraceLog
 			case RowDataType::IY: WriteIntValue(output, (uint16_t)(cpuState.IYL | (cpuState.IYH << 8)), rowPart); break;
 			case RowDataType::SP: WriteIntValue(output, cpuState.SP, rowPart); break;
 			case RowDataType::PS: GetStatusFlag(activeStatusLetters, inactiveStatusLetters, output, cpuState.Flags, rowPart, 8); break;
-			default: ProcessSharedTag(rowPart, output, cpuState, vdpState, disassemblyInfo); break;
+			default: ProcessSharedTag(rowPart, output, cpuState, vdpState, disassemblyInfo, capturedAddress); break;
 		}
 	}
 }
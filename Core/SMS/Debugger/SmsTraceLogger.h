@@ -18,7 +18,7 @@ protected:
 public:
 	SmsTraceLogger(Debugger* debugger, IDebugger* cpuDebugger, SmsVdp* vdp);
 	
-	void GetTraceRow(string& output, SmsCpuState& cpuState, TraceLogPpuState& vdpState, DisassemblyInfo& disassemblyInfo);
+	void GetTraceRow(string& output, SmsCpuState& cpuState, TraceLogPpuState& vdpState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress);
 	void LogPpuState();
 
 	__forceinline uint32_t GetProgramCounter(SmsCpuState& state) { return state.PC; }
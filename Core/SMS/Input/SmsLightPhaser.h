@@ -26,11 +26,11 @@ protected:
 
 	void InternalSetStateFromInput() override
 	{
-		MousePosition pos = KeyManager::GetMousePosition();
+		MousePosition pos = _emu->GetKeyManager()->GetMousePosition();
 
 		for(KeyMapping& keyMapping : _keyMappings) {
-			SetPressedState(Buttons::Fire, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));
-			if(KeyManager::IsKeyPressed(keyMapping.CustomKeys[1])) {
+			SetPressedState(Buttons::Fire, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));
+			if(_emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[1])) {
 				pos.X = -1;
 				pos.Y = -1;
 			}
@@ -129,14 +129,26 @@ void SmsConsole::RunFrame()
 	UpdateRegion(false);
 
 	uint32_t frame = _vdp->GetFrameCount();
-	while(frame == _vdp->GetFrameCount()) {
-		_cpu->Exec();
+	//The instantiation is picked once per frame, like on the GBA (the debugger is attached between frames,
+	//and the <true> instantiation still checks for it at runtime if it is detached mid-frame)
+	if(_emu->IsDebugging()) {
+		RunCpu<true>(frame);
+	} else {
+		RunCpu<false>(frame);
 	}
 
 	_psg->Run();
 	_psg->PlayQueuedAudio();
 }
 
+template<bool debuggerEnabled>
+void SmsConsole::RunCpu(uint32_t frame)
+{
+	while(frame == _vdp->GetFrameCount()) {
+		_cpu->Exec<debuggerEnabled>();
+	}
+}
+
 void SmsConsole::ProcessEndOfFrame()
 {
 	_controlManager->UpdateControlDevices();
@@ -32,6 +32,7 @@ private:
 	ConsoleRegion _region = ConsoleRegion::Ntsc;
 	
 	void UpdateRegion(bool forceUpdate);
+	template<bool debuggerEnabled> void RunCpu(uint32_t frame);
 
 public:
 	static vector<string> GetSupportedExtensions() { return { ".sms", ".gg", ".sg" }; }
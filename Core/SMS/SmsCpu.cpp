@@ -30,16 +30,21 @@ SmsCpuState& SmsCpu::GetState()
 	return _state;
 }
 
+template<bool debuggerEnabled>
 void SmsCpu::Exec()
 {
 	uint8_t opCode = 0;
 	_state.FlagsChanged <<= 1;
 	if(_state.Halted) {
-		_emu->ProcessHaltedCpu<CpuType::Sms>();
+		if constexpr(debuggerEnabled) {
+			_emu->ProcessHaltedCpu<CpuType::Sms>();
+		}
 		ExecCycles(4);
 	} else {
 		#ifndef DUMMYCPU
-		_emu->ProcessInstruction<CpuType::Sms>();
+		if constexpr(debuggerEnabled) {
+			_emu->ProcessInstruction<CpuType::Sms>();
+		}
 		#endif
 		opCode = ReadOpCode();
 		ExecOpCode<0>(opCode);
@@ -79,6 +84,9 @@ void SmsCpu::Exec()
 	}
 }
 
+template void SmsCpu::Exec<false>();
+template void SmsCpu::Exec<true>();
+
 template<uint8_t prefix>
 void SmsCpu::ExecOpCode(uint8_t opCode)
 {
@@ -90,7 +90,13 @@ void SmsNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 			case 240: linesToSkip = 48; break;
 		}
 
-		snes_ntsc_blit(_snesNtscData.get(), ppuOutputBuffer + linesToSkip * 256 + 48, 256, 0, _baseFrameInfo.Width, _baseFrameInfo.Height, _snesNtscBuffer, SNES_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+		//The burst phase moves forward by 1 on each row, so each band starts at the phase the serial blit would be at
+		uint16_t* in = ppuOutputBuffer + linesToSkip * 256 + 48;
+		uint32_t width = _baseFrameInfo.Width;
+		snes_ntsc_t* ntscData = _snesNtscData.get();
+		GetWorkerPool()->RunRowBands(_baseFrameInfo.Height, [=](uint32_t firstRow, uint32_t endRow) {
+			snes_ntsc_blit(ntscData, in + firstRow * 256, 256, firstRow % snes_ntsc_burst_count, width, endRow - firstRow, _snesNtscBuffer + firstRow * baseWidth, baseWidth * 4);
+		});
 
 		for(uint32_t i = 0; i < frame.Height; i += 2) {
 			memcpy(GetOutputBuffer() + i * frame.Width, _snesNtscBuffer + yOffset + xOffset + (i / 2) * baseWidth, frame.Width * sizeof(uint32_t));
@@ -98,7 +104,11 @@ void SmsNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		}
 	} else {
 		uint32_t baseWidth = SMS_NTSC_OUT_WIDTH(_baseFrameInfo.Width);
-		sms_ntsc_blit(_ntscData.get(), ppuOutputBuffer, _baseFrameInfo.Width, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, SMS_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+		uint32_t width = _baseFrameInfo.Width;
+		sms_ntsc_t* ntscData = _ntscData.get();
+		GetWorkerPool()->RunRowBands(_baseFrameInfo.Height, [=](uint32_t firstRow, uint32_t endRow) {
+			sms_ntsc_blit(ntscData, ppuOutputBuffer + firstRow * width, width, width, endRow - firstRow, _ntscBuffer + firstRow * baseWidth, baseWidth * 4);
+		});
 
 		uint32_t linesToSkip;
 		uint32_t scanlineCount = _console->GetVdp()->GetState().VisibleScanlineCount;
@@ -511,10 +511,12 @@ void BaseCartridge::InitCoprocessor()
 		_coprocessor.reset(new Sa1(_console));
 		_sa1 = dynamic_cast<Sa1*>(_coprocessor.get());
 		_needCoprocSync = true;
+		_needCoprocCycleSync = true;
 	} else if(_coprocessorType == CoprocessorType::GSU) {
 		_coprocessor.reset(new Gsu(_console, _coprocessorRamSize));
 		_gsu = dynamic_cast<Gsu*>(_coprocessor.get());
 		_needCoprocSync = true;
+		_needCoprocCycleSync = true;
 	} else if(_coprocessorType == CoprocessorType::SDD1) {
 		_coprocessor.reset(new Sdd1(_console));
 	} else if(_coprocessorType == CoprocessorType::SPC7110) {
@@ -535,6 +537,7 @@ void BaseCartridge::InitCoprocessor()
 		_coprocessor.reset(new Cx4(_console));
 		_cx4 = dynamic_cast<Cx4*>(_coprocessor.get());
 		_needCoprocSync = true;
+		_needCoprocCycleSync = true;
 	} else if(_coprocessorType == CoprocessorType::OBC1 && _saveRamSize > 0) {
 		_coprocessor.reset(new Obc1(_console, _saveRam, _saveRamSize));
 	} else if(_coprocessorType == CoprocessorType::SGB) {
@@ -35,6 +35,7 @@ private:
 	uint32_t _headerOffset = 0;
 
 	bool _needCoprocSync = false;
+	bool _needCoprocCycleSync = false;
 	unique_ptr<BaseCoprocessor> _coprocessor;
 	
 	NecDsp *_necDsp = nullptr;
@@ -138,6 +139,10 @@ public:
 		}
 	}
 
+	bool NeedCoprocessorSync() { return _needCoprocSync; }
+
+	//SA-1, GSU and CX4 share the cartridge bus (and the IRQ line) with the main CPU, they need to be synced on every CPU cycle
+	bool NeedCoprocessorCycleSync() { return _needCoprocCycleSync; }
 	BaseCoprocessor* GetCoprocessor();
 
 	vector<unique_ptr<IMemoryHandler>>& GetPrgRomHandlers();
@@ -50,5 +50,8 @@ public:
 
 		uint8_t Read(uint32_t addr) override;
 		void Write(uint32_t addr, uint8_t value) override;
+
+		//Reads depend on the flash command state
+		uint8_t* GetDirectReadMemory(uint32_t& mask) override { return nullptr; }
 	};
 };
@@ -458,7 +458,7 @@ uint8_t Sa1::ReadSa1(uint32_t addr, MemoryOperationType type)
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	uint8_t value;
 	if(handler) {
-		value = handler->Read(addr);
+		value = _mappings.Read(handler, addr);
 		_lastAccessMemType = handler->GetMemoryType();
 		_openBus = value;
 	} else {
@@ -501,11 +501,14 @@ void Sa1::Run()
 
 	while(_cpu->GetCycleCount() < targetCycle) {
 		if(_state.Sa1Wait || _state.Sa1Reset) {
-			_cpu->IncreaseCycleCount<1>();
+			//Only the SNES CPU can take the SA-1 out of wait/reset, skip to the target cycle directly
+			_cpu->IncreaseCycleCount(targetCycle - _cpu->GetCycleCount());
 		} else if(_state.DmaRunning) {
 			RunDma();
+		} else if(_emu->IsDebugging()) {
+			_cpu->Exec<true>();
 		} else {
-			_cpu->Exec();
+			_cpu->Exec<false>();
 		}
 	}
 }
@@ -24,13 +24,16 @@ Sa1Cpu::~Sa1Cpu()
 {
 }
 
+template<bool debuggerEnabled>
 void Sa1Cpu::Exec()
 {
 	_immediateMode = false;
 	_readWriteMask = 0xFFFFFF;
 
 	if(_state.StopState == SnesCpuStopState::Running) {
-		_emu->ProcessInstruction<CpuType::Sa1>();
+		if constexpr(debuggerEnabled) {
+			_emu->ProcessInstruction<CpuType::Sa1>();
+		}
 		RunOp();
 		CheckForInterrupts();
 	} else {
@@ -38,6 +41,9 @@ void Sa1Cpu::Exec()
 	}
 }
 
+template void Sa1Cpu::Exec<false>();
+template void Sa1Cpu::Exec<true>();
+
 void Sa1Cpu::CheckForInterrupts()
 {
 	//Use the state of the IRQ/NMI flags on the previous cycle to determine if an IRQ is processed or not
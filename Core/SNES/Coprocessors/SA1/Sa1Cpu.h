@@ -327,7 +327,7 @@ public:
 	void PowerOn();
 
 	void Reset();
-	void Exec();
+	template<bool debuggerEnabled = true> void Exec();
 
 	SnesCpuState& GetState();
 	uint64_t GetCycleCount();
@@ -59,7 +59,7 @@ RowDataType GsuTraceLogger::GetFormatTagType(string& tag)
 	}
 }
 
-void GsuTraceLogger::GetTraceRow(string &output, GsuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo)
+void GsuTraceLogger::GetTraceRow(string &output, GsuState &cpuState, TraceLogPpuState &ppuState, DisassemblyInfo &disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 {
 	for(RowPart& rowPart : _rowParts) {
 		switch(rowPart.DataType) {
@@ -90,7 +90,7 @@ void GsuTraceLogger::GetTraceRow(string &output, GsuState &cpuState, TraceLogPpu
 				break;
 			}
 
-			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo); break;
+			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo, capturedAddress); break;
 		}
 	}
 }
@@ -55,7 +55,7 @@ void NecDspTraceLogger::WriteAccFlagsValue(string& output, NecDspAccFlags flags,
 	WriteStringValue(output, status, rowPart);
 }
 
-void NecDspTraceLogger::GetTraceRow(string& output, NecDspState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo)
+void NecDspTraceLogger::GetTraceRow(string& output, NecDspState& cpuState, TraceLogPpuState& ppuState, DisassemblyInfo& disassemblyInfo, TraceLogEffectiveAddress* capturedAddress)
 {
 	for(RowPart& rowPart : _rowParts) {
 		switch(rowPart.DataType) {
@@ -74,7 +74,7 @@ void NecDspTraceLogger::GetTraceRow(string& output, NecDspState& cpuState, Trace
 			case RowDataType::TR: WriteIntValue(output, cpuState.TR, rowPart); break;
 			case RowDataType::TRB: WriteIntValue(output, cpuState.TRB, rowPart); break;
 
-			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo); break;
+			default: ProcessSharedTag(rowPart, output, cpuState, ppuState, disassemblyInfo, capturedAddress); break;
 		}
 	}
 }
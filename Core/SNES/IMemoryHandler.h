@@ -20,6 +20,9 @@ public:
 	virtual void PeekBlock(uint32_t addr, uint8_t *output) = 0;
 	virtual void Write(uint32_t addr, uint8_t value) = 0;
 
+	//Returns the memory mapped to the handler's page if reading it has no side effects (value = memory[addr & mask]), nullptr otherwise
+	virtual uint8_t* GetDirectReadMemory(uint32_t& mask) { return nullptr; }
+
 	__forceinline MemoryType GetMemoryType()
 	{
 		return _memoryType;
@@ -39,10 +39,10 @@ protected:
 	void InternalSetStateFromInput() override
 	{
 		for(KeyMapping& keyMapping : _keyMappings) {
-			SetPressedState(Buttons::Left, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));
-			SetPressedState(Buttons::Right, KeyManager::IsKeyPressed(keyMapping.CustomKeys[1]));
+			SetPressedState(Buttons::Left, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));
+			SetPressedState(Buttons::Right, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[1]));
 		}
-		SetMovement(KeyManager::GetMouseMovement(_emu, _settings->GetInputConfig().MouseSensitivity));
+		SetMovement(_emu->GetKeyManager()->GetMouseMovement(_settings->GetInputConfig().MouseSensitivity));
 	}
 
 public:
@@ -27,13 +27,13 @@ protected:
 	void InternalSetStateFromInput() override
 	{
 		for(KeyMapping& keyMapping : _keyMappings) {
-			SetPressedState(Buttons::Fire, KeyManager::IsKeyPressed(keyMapping.CustomKeys[0]));
-			SetPressedState(Buttons::Cursor, KeyManager::IsKeyPressed(keyMapping.CustomKeys[1]));
-			SetPressedState(Buttons::Turbo, KeyManager::IsKeyPressed(keyMapping.CustomKeys[2]));
-			SetPressedState(Buttons::Pause, KeyManager::IsKeyPressed(keyMapping.CustomKeys[3]));
+			SetPressedState(Buttons::Fire, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[0]));
+			SetPressedState(Buttons::Cursor, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[1]));
+			SetPressedState(Buttons::Turbo, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[2]));
+			SetPressedState(Buttons::Pause, _emu->GetKeyManager()->IsKeyPressed(keyMapping.CustomKeys[3]));
 		}
 
-		MousePosition pos = KeyManager::GetMousePosition();
+		MousePosition pos = _emu->GetKeyManager()->GetMousePosition();
 		SetCoordinates(pos);
 	}
 
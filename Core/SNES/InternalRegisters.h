@@ -31,6 +31,7 @@ private:
 	uint64_t _autoReadNextClock = 0;
 
 	void SetIrqFlag(bool irqFlag);
+	__forceinline bool GetIrqLevel();
 	
 	bool IsAutoReadActive();
 	uint8_t ReadControllerData(uint8_t port, bool getMsb);
@@ -45,6 +46,8 @@ public:
 	void ProcessAutoJoypad();
 
 	__forceinline void ProcessIrqCounters();
+	__forceinline bool IsIrqCounterIdle(uint16_t startClock, uint16_t endClock);
+	__forceinline void SkipIrqCounters();
 
 	uint8_t GetIoPortOutput();
 	void SetNmiFlag(bool nmiFlag);
@@ -75,11 +78,7 @@ void InternalRegisters::ProcessIrqCounters()
 		}
 	}
 
-	bool irqLevel = (
-		(_state.EnableHorizontalIrq || _state.EnableVerticalIrq) &&
-		(!_state.EnableHorizontalIrq || (_state.HorizontalTimer <= 339 && (_ppu->GetCycle() == _state.HorizontalTimer) && (_ppu->GetLastScanline() != _ppu->GetRealScanline() || _state.HorizontalTimer < 339))) &&
-		(!_state.EnableVerticalIrq || _ppu->GetRealScanline() == _state.VerticalTimer)
-	);
+	bool irqLevel = GetIrqLevel();
 
 	if(!_irqLevel && irqLevel) {
 		//Trigger IRQ signal 16 master clocks later
@@ -87,4 +86,41 @@ void InternalRegisters::ProcessIrqCounters()
 	}
 	_irqLevel = irqLevel;
 	_cpu->SetNmiFlag(_state.EnableNmi & _nmiFlag);
+}
+
+bool InternalRegisters::GetIrqLevel()
+{
+	return (
+		(_state.EnableHorizontalIrq || _state.EnableVerticalIrq) &&
+		(!_state.EnableHorizontalIrq || (_state.HorizontalTimer <= 339 && (_ppu->GetCycle() == _state.HorizontalTimer) && (_ppu->GetLastScanline() != _ppu->GetRealScanline() || _state.HorizontalTimer < 339))) &&
+		(!_state.EnableVerticalIrq || _ppu->GetRealScanline() == _state.VerticalTimer)
+	);
+}
+
+bool InternalRegisters::IsIrqCounterIdle(uint16_t startClock, uint16_t endClock)
+{
+	//Returns true when ProcessIrqCounters can't start or trigger an IRQ for any of the dots in (startClock, endClock]
+	//(as long as the scanline and the registers don't change in the meantime)
+	if(_needIrq > 0) {
+		return false;
+	} else if(!_state.EnableHorizontalIrq && !_state.EnableVerticalIrq) {
+		return true;
+	} else if(_state.EnableVerticalIrq && _ppu->GetRealScanline() != _state.VerticalTimer) {
+		return true;
+	} else if(!_state.EnableHorizontalIrq) {
+		//The level stays high for the entire scanline, only the first dot can start an IRQ
+		return _irqLevel;
+	}
+
+	//The level can only be high on the dot that matches the horizontal timer
+	uint16_t firstDot = SnesPpu::GetCycle((startClock & ~0x03) + 4);
+	uint16_t lastDot = SnesPpu::GetCycle(endClock & ~0x03);
+	return _state.HorizontalTimer < firstDot || _state.HorizontalTimer > lastDot;
+}
+
+void InternalRegisters::SkipIrqCounters()
+{
+	//Same result as calling ProcessIrqCounters for each dot of a range where IsIrqCounterIdle returned true
+	_irqLevel = GetIrqLevel();
+	_cpu->SetNmiFlag(_state.EnableNmi & _nmiFlag);
 }
\ No newline at end of file
@@ -1,19 +1,36 @@
 #pragma once
 #include "pch.h"
 #include "Debugger/DebugTypes.h"
-
-class IMemoryHandler;
+#include "SNES/IMemoryHandler.h"
 
 class MemoryMappings
 {
 private:
 	IMemoryHandler* _handlers[0x100 * 0x10] = {};
 
+	//Memory for pages mapped to plain RAM/ROM handlers (nullptr for registers, etc.), used to bypass the handler's virtual Read call
+	uint8_t* _pages[0x100 * 0x10] = {};
+	uint16_t _pageMasks[0x100 * 0x10] = {};
+
+	void SetHandler(uint16_t page, IMemoryHandler* handler);
+
 public:
 	void RegisterHandler(uint8_t startBank, uint8_t endBank, uint16_t startPage, uint16_t endPage, vector<unique_ptr<IMemoryHandler>>& handlers, uint16_t pageIncrement = 0, uint16_t startPageNumber = 0);
 	void RegisterHandler(uint8_t startBank, uint8_t endBank, uint16_t startAddr, uint16_t endAddr, IMemoryHandler* handler);
 
 	IMemoryHandler* GetHandler(uint32_t addr);
+
+	//Reads the value from the page's memory directly when possible, otherwise calls handler->Read()
+	//handler must be the value returned by GetHandler(addr)
+	__forceinline uint8_t Read(IMemoryHandler* handler, uint32_t addr)
+	{
+		uint16_t page = addr >> 12;
+		if(_pages[page]) {
+			return _pages[page][addr & _pageMasks[page]];
+		}
+		return handler->Read(addr);
+	}
+
 	AddressInfo GetAbsoluteAddress(uint32_t addr);
 	int GetRelativeAddress(AddressInfo& absAddress, uint8_t startBank = 0);
 
@@ -52,6 +52,12 @@ public:
 		_ram[addr & _mask] = value;
 	}
 
+	uint8_t* GetDirectReadMemory(uint32_t& mask) override
+	{
+		mask = _mask;
+		return _ram;
+	}
+
 	AddressInfo GetAbsoluteAddress(uint32_t address) override
 	{
 		AddressInfo info;
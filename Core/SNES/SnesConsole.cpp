@@ -61,13 +61,25 @@ void SnesConsole::RunFrame()
 
 	_frameRunning = true;
 
-	while(_frameRunning) {
-		_cpu->Exec();
+	//The instantiation is picked once per frame, like on the GBA (the debugger is attached between frames,
+	//and the <true> instantiation still checks for it at runtime if it is detached mid-frame)
+	if(_emu->IsDebugging()) {
+		RunCpu<true>();
+	} else {
+		RunCpu<false>();
 	}
 
 	_spc->ProcessEndFrame();
 }
 
+template<bool debuggerEnabled>
+void SnesConsole::RunCpu()
+{
+	while(_frameRunning) {
+		_cpu->Exec<debuggerEnabled>();
+	}
+}
+
 void SnesConsole::ProcessEndOfFrame()
 {
 	_cart->RunCoprocessors();
@@ -66,6 +66,7 @@ private:
 	bool _frameRunning = false;
 
 	void UpdateRegion();
+	template<bool debuggerEnabled> void RunCpu();
 	bool LoadSpcFile(VirtualFile& romFile);
 
 public:
@@ -26,6 +26,7 @@ SnesCpu::~SnesCpu()
 {
 }
 
+template<bool debuggerEnabled>
 void SnesCpu::Exec()
 {
 	_immediateMode = false;
@@ -33,16 +34,21 @@ void SnesCpu::Exec()
 
 	if(_state.StopState == SnesCpuStopState::Running) {
 #ifndef DUMMYCPU
-		_emu->ProcessInstruction<CpuType::Snes>();
+		if constexpr(debuggerEnabled) {
+			_emu->ProcessInstruction<CpuType::Snes>();
+		}
 #endif
 
 		RunOp();
 		CheckForInterrupts();
 	} else {
-		ProcessHaltedState();
+		ProcessHaltedState<debuggerEnabled>();
 	}
 }
 
+template void SnesCpu::Exec<false>();
+template void SnesCpu::Exec<true>();
+
 void SnesCpu::CheckForInterrupts()
 {
 #ifndef DUMMYCPU
@@ -61,10 +67,13 @@ void SnesCpu::CheckForInterrupts()
 #endif
 }
 
+template<bool debuggerEnabled>
 void SnesCpu::ProcessHaltedState()
 {
 #ifndef DUMMYCPU
-	_emu->ProcessHaltedCpu<CpuType::Snes>();
+	if constexpr(debuggerEnabled) {
+		_emu->ProcessHaltedCpu<CpuType::Snes>();
+	}
 #endif
 
 	if(_state.StopState == SnesCpuStopState::Stopped) {
@@ -91,6 +100,7 @@ void SnesCpu::Idle()
 	ProcessCpuCycle();
 	_memoryManager->IncMasterClock6();
 	_emu->ProcessIdleCycle<CpuType::Snes>();
+	_memoryManager->ProcessCpuCycleEnd();
 	UpdateIrqNmiFlags();
 #endif
 }
@@ -108,6 +118,7 @@ void SnesCpu::IdleOrDummyWrite(uint32_t addr, uint8_t value)
 		_emu->ProcessIdleCycle<CpuType::Snes>();
 	}
 
+	_memoryManager->ProcessCpuCycleEnd();
 	UpdateIrqNmiFlags();
 #endif
 }
@@ -146,6 +157,7 @@ uint8_t SnesCpu::Read(uint32_t addr, MemoryOperationType type)
 	_memoryManager->SetCpuSpeed(_memoryManager->GetCpuSpeed(addr));
 	ProcessCpuCycle();
 	uint8_t value = _memoryManager->Read(addr, type);
+	_memoryManager->ProcessCpuCycleEnd();
 	UpdateIrqNmiFlags();
 	return value;
 }
@@ -155,6 +167,7 @@ void SnesCpu::Write(uint32_t addr, uint8_t value, MemoryOperationType type)
 	_memoryManager->SetCpuSpeed(_memoryManager->GetCpuSpeed(addr));
 	ProcessCpuCycle();
 	_memoryManager->Write(addr, value, type);
+	_memoryManager->ProcessCpuCycleEnd();
 	UpdateIrqNmiFlags();
 }
 #endif
@@ -324,7 +324,7 @@ private:
 	void AddrMode_StkRelIndIdxY();
 	
 	void RunOp();
-	__noinline void ProcessHaltedState();
+	template<bool debuggerEnabled> __noinline void ProcessHaltedState();
 	__forceinline void CheckForInterrupts();
 
 public:
@@ -339,7 +339,10 @@ public:
 	void PowerOn();
 
 	void Reset();
-	void Exec();
+
+	//The instruction/halted cpu debugger hooks are only compiled into the <true> instantiation
+	//(memory and PPU hooks are shared by both and still check for the debugger at runtime, as on the GBA)
+	template<bool debuggerEnabled = true> void Exec();
 
 	SnesCpuState& GetState();
 	uint64_t GetCycleCount();
@@ -6,6 +6,7 @@
 #include "Shared/EmuSettings.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoKernels.h"
 
 SnesDefaultVideoFilter::SnesDefaultVideoFilter(Emulator* emu) : BaseVideoFilter(emu)
 {
@@ -92,35 +93,22 @@ void SnesDefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 
 	if(_baseFrameInfo.Width == 256 && _forceFixedRes) {
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i * frameInfo.Width + j] = GetPixel(ppuOutputBuffer, i / 2 * width + j / 2 + yOffset + xOffset);
+			uint32_t* outRow = out + i * frameInfo.Width;
+			if(i & 0x01) {
+				//Odd rows are identical to the row above them
+				memcpy(outRow, outRow - frameInfo.Width, frameInfo.Width * sizeof(uint32_t));
+			} else {
+				VideoKernels::ConvertPixelsDoubleWidth(_calculatedPalette, ppuOutputBuffer + i / 2 * width + yOffset + xOffset, outRow, frameInfo.Width / 2);
 			}
 		}
 	} else {
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i*frameInfo.Width+j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-			}
+			VideoKernels::ConvertPixels(_calculatedPalette, ppuOutputBuffer + i * width + yOffset + xOffset, out + i * frameInfo.Width, frameInfo.Width);
 		}
 	}
 
 	if(_baseFrameInfo.Width == 512 && _blendHighRes) {
 		//Very basic blend effect for high resolution modes
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				uint32_t &pixel1 = out[i*frameInfo.Width + j];
-				pixel1 = BlendPixels(pixel1, out[i * frameInfo.Width + j + 1]);
-			}
-		}
+		VideoKernels::BlendWithNextPixel(out, frameInfo.Height * frameInfo.Width);
 	}
 }
-
-uint32_t SnesDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
-{
-	return _calculatedPalette[ppuFrame[offset]];
-}
-
-uint32_t SnesDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
@@ -15,9 +15,6 @@ private:
 
 	void InitLookupTable();
 
-	__forceinline static uint32_t BlendPixels(uint32_t a, uint32_t b);
-	__forceinline uint32_t GetPixel(uint16_t* ppuFrame, uint32_t offset);
-
 protected:
 	void OnBeforeApplyFilter() override;
 	FrameInfo GetFrameInfo() override;
@@ -29,6 +29,9 @@ void SnesMemoryManager::Initialize(SnesConsole *console)
 	_ppu = console->GetPpu();
 	_cart = console->GetCartridge();
 	_cheatManager = _emu->GetCheatManager();
+	_useClockScheduler = !_emu->GetSettings()->CheckFlag(EmulationFlags::DisableClockScheduler);
+	_batchCoprocSync = _useClockScheduler && _emu->GetSettings()->CheckFlag(EmulationFlags::BatchCoprocessorSync);
+	_syncCoprocOnCpuCycle = _batchCoprocSync && _cart->NeedCoprocessorCycleSync();
 
 	_workRam = new uint8_t[SnesMemoryManager::WorkRamSize];
 	_emu->RegisterMemory(MemoryType::SnesWorkRam, _workRam, SnesMemoryManager::WorkRamSize);
@@ -82,6 +85,7 @@ void SnesMemoryManager::Reset()
 	_dramRefreshPosition = 538 - (_masterClock & 0x07);
 	_nextEventClock = _dramRefreshPosition;
 	_nextEvent = SnesEventType::DramRefresh;
+	_nextCoprocSyncClock = 0;
 }
 
 void SnesMemoryManager::GenerateMasterClockTable()
@@ -125,33 +129,68 @@ void SnesMemoryManager::GenerateMasterClockTable()
 	}
 }
 
+bool SnesMemoryManager::SkipClocks(uint16_t clocks)
+{
+	//Moves the clock forward in a single step when nothing can happen before the end of the given clock range:
+	//no scheduled event (HDMA, DRAM refresh, end of scanline), no IRQ that could start or trigger, no coprocessor sync
+	//and no debugger. Otherwise, Exec() steps through the range 2 clocks at a time.
+	uint16_t endClock = _hClock + clocks;
+	if(endClock >= _nextEventClock || !_useClockScheduler || _emu->IsDebugging()) {
+		return false;
+	} else if(_cart->NeedCoprocessorSync() && (!_batchCoprocSync || _masterClock + clocks >= _nextCoprocSyncClock)) {
+		return false;
+	}
+
+	//ProcessIrqCounters runs on every clock that is a multiple of 4
+	bool processIrqCounters = (endClock & ~0x03) > _hClock;
+	if(processIrqCounters && !_regs->IsIrqCounterIdle(_hClock, endClock)) {
+		return false;
+	}
+
+	_masterClock += clocks;
+	_hClock = endClock;
+
+	if(processIrqCounters) {
+		_regs->SkipIrqCounters();
+	}
+	return true;
+}
+
 void SnesMemoryManager::IncMasterClock4()
 {
-	Exec();
-	Exec();
+	if(!SkipClocks(4)) {
+		Exec();
+		Exec();
+	}
 }
 
 void SnesMemoryManager::IncMasterClock6()
 {
-	Exec();
-	Exec();
-	Exec();
+	if(!SkipClocks(6)) {
+		Exec();
+		Exec();
+		Exec();
+	}
 }
 
 void SnesMemoryManager::IncMasterClock8()
 {
-	Exec();
-	Exec();
-	Exec();
-	Exec();
+	if(!SkipClocks(8)) {
+		Exec();
+		Exec();
+		Exec();
+		Exec();
+	}
 }
 
 void SnesMemoryManager::IncMasterClock40()
 {
-	Exec(); Exec(); Exec(); Exec(); Exec();
-	Exec(); Exec(); Exec(); Exec(); Exec();
-	Exec(); Exec(); Exec(); Exec(); Exec();
-	Exec(); Exec(); Exec(); Exec(); Exec();
+	if(!SkipClocks(40)) {
+		Exec(); Exec(); Exec(); Exec(); Exec();
+		Exec(); Exec(); Exec(); Exec(); Exec();
+		Exec(); Exec(); Exec(); Exec(); Exec();
+		Exec(); Exec(); Exec(); Exec(); Exec();
+	}
 }
 
 void SnesMemoryManager::IncMasterClockStartup()
@@ -163,6 +202,10 @@ void SnesMemoryManager::IncMasterClockStartup()
 
 void SnesMemoryManager::IncrementMasterClockValue(uint16_t cyclesToRun)
 {
+	if(cyclesToRun == 0 || SkipClocks(cyclesToRun)) {
+		return;
+	}
+
 	switch(cyclesToRun) {
 		case 12: Exec(); [[fallthrough]];
 		case 10: Exec(); [[fallthrough]];
@@ -187,7 +230,35 @@ void SnesMemoryManager::Exec()
 		_regs->ProcessIrqCounters();
 	}
 
+	if(!_batchCoprocSync) {
+		_cart->SyncCoprocessors();
+	} else if(_masterClock >= _nextCoprocSyncClock) {
+		SyncCoprocessors();
+	}
+}
+
+void SnesMemoryManager::SyncCoprocessors()
+{
+	//With BatchCoprocessorSync, coprocessors run behind the main CPU and catch up to the current clock when they are synced
 	_cart->SyncCoprocessors();
+	_nextCoprocSyncClock = _masterClock + SnesMemoryManager::CoprocessorSyncInterval;
+}
+
+void SnesMemoryManager::SyncCoprocessors(IMemoryHandler* handler)
+{
+	if(!_batchCoprocSync) {
+		//Coprocessors are synced on every step, they are never behind
+		return;
+	} else if(_syncCoprocOnCpuCycle) {
+		//SA-1/GSU/CX4: catch up before every access, before the bus access type changes (the coprocessor's
+		//ROM/RAM accesses depend on what the main CPU is accessing, e.g SA-1 bus conflicts, GSU ROM access)
+		SyncCoprocessors();
+	} else if(_cart->NeedCoprocessorSync()) {
+		//SGB: only the SGB ports are shared, catch up before accessing registers
+		if(handler->GetMemoryType() == MemoryType::SnesRegister) {
+			SyncCoprocessors();
+		}
+	}
 }
 
 void SnesMemoryManager::ProcessEvent()
@@ -200,10 +271,8 @@ void SnesMemoryManager::ProcessEvent()
 			break;
 
 		case SnesEventType::DramRefresh:
-			IncMasterClock40();
-			//TODOv2?
-			//_cpu->IncreaseCycleCount<5>();
-
+			//Schedule the next event before running the refresh's 40 clocks, which allows them to be skipped
+			//in a single step (neither event can occur during the refresh)
 			if(_ppu->GetScanline() < _ppu->GetVblankStart()) {
 				_nextEvent = SnesEventType::HdmaStart;
 				_nextEventClock = 276 * 4;
@@ -211,6 +280,10 @@ void SnesMemoryManager::ProcessEvent()
 				_nextEvent = SnesEventType::EndOfScanline;
 				_nextEventClock = 1360;
 			}
+
+			IncMasterClock40();
+			//TODOv2?
+			//_cpu->IncreaseCycleCount<5>();
 			break;
 
 		case SnesEventType::HdmaStart:
@@ -243,7 +316,8 @@ uint8_t SnesMemoryManager::Read(uint32_t addr, MemoryOperationType type)
 	uint8_t value;
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	if(handler) {
-		value = handler->Read(addr);
+		SyncCoprocessors(handler);
+		value = _mappings.Read(handler, addr);
 		_memTypeBusA = handler->GetMemoryType();
 		_openBus = value;
 	} else {
@@ -267,6 +341,7 @@ uint8_t SnesMemoryManager::ReadDma(uint32_t addr, bool forBusA)
 	uint8_t value;
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
+		SyncCoprocessors(handler);
 		if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
 			//Trying to read from bus B using bus A returns open bus
 			value = _openBus;
@@ -279,7 +354,7 @@ uint8_t SnesMemoryManager::ReadDma(uint32_t addr, bool forBusA)
 				value = handler->Read(addr);
 			}
 		} else {
-			value = handler->Read(addr);
+			value = _mappings.Read(handler, addr);
 			if(handler != _registerHandlerB.get()) {
 				_memTypeBusA = handler->GetMemoryType();
 			}
@@ -318,6 +393,7 @@ void SnesMemoryManager::Write(uint32_t addr, uint8_t value, MemoryOperationType
 	if(_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, type)) {
 		IMemoryHandler* handler = _mappings.GetHandler(addr);
 		if(handler) {
+			SyncCoprocessors(handler);
 			handler->Write(addr, value);
 			_memTypeBusA = handler->GetMemoryType();
 		} else {
@@ -334,6 +410,7 @@ void SnesMemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA)
 	if(_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, MemoryOperationType::DmaWrite)) {
 		IMemoryHandler* handler = _mappings.GetHandler(addr);
 		if(handler) {
+			SyncCoprocessors(handler);
 			if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
 				//Trying to write to bus B using bus A does nothing
 			} else if(handler == _registerHandlerA.get()) {
@@ -422,6 +499,12 @@ void SnesMemoryManager::Serialize(Serializer &s)
 {
 	SV(_masterClock); SV(_openBus); SV(_cpuSpeed); SV(_hClock); SV(_dramRefreshPosition);
 	SV(_memTypeBusA); SV(_nextEvent); SV(_nextEventClock);
+
+	if(!s.IsSaving()) {
+		//Sync the coprocessors right away when loading states that don't contain this value
+		_nextCoprocSyncClock = 0;
+	}
+	SV(_nextCoprocSyncClock);
 	SVArray(_workRam, SnesMemoryManager::WorkRamSize);
 	SV(_registerHandlerB);
 }
@@ -31,6 +31,9 @@ class SnesMemoryManager : public ISerializable
 public:
 	constexpr static uint32_t WorkRamSize = 0x20000;
 
+	//Max number of master clocks the coprocessors (SA-1, GSU, CX4, SGB) can fall behind the main CPU before they are synced (with BatchCoprocessorSync)
+	constexpr static uint32_t CoprocessorSyncInterval = 64;
+
 private:
 	SnesConsole* _console = nullptr;
 	Emulator* _emu = nullptr;
@@ -58,8 +61,17 @@ private:
 	MemoryMappings _mappings = {};
 	vector<unique_ptr<IMemoryHandler>> _workRamHandlers;
 	uint8_t _masterClockTable[0x800] = {};
+	bool _useClockScheduler = true;
+
+	//Coprocessors are synced on every step, unless the (experimental) BatchCoprocessorSync flag is set
+	bool _batchCoprocSync = false;
+	uint64_t _nextCoprocSyncClock = 0;
+	bool _syncCoprocOnCpuCycle = false;
 
 	void Exec();
+	__forceinline bool SkipClocks(uint16_t clocks);
+	void SyncCoprocessors();
+	__forceinline void SyncCoprocessors(IMemoryHandler* handler);
 
 	void ProcessEvent();
 
@@ -78,6 +90,16 @@ public:
 	void IncMasterClockStartup();
 	void IncrementMasterClockValue(uint16_t value);
 
+	//Called at the end of every main CPU cycle, before the CPU latches its IRQ/NMI lines
+	__forceinline void ProcessCpuCycleEnd()
+	{
+		if(_syncCoprocOnCpuCycle) {
+			//Coprocessors that share the bus/IRQ line with the CPU must have caught up with this cycle, otherwise their
+			//IRQs are latched late and they see the wrong bus access type (e.g SA-1 bus conflict wait states)
+			SyncCoprocessors();
+		}
+	}
+
 	uint8_t Read(uint32_t addr, MemoryOperationType type);
 	uint8_t ReadDma(uint32_t addr, bool forBusA);
 
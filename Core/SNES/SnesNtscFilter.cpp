@@ -58,14 +58,22 @@ void SnesNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t xOffset = overscan.Left;
 	uint32_t yOffset = overscan.Top/2 * baseWidth;
 
+	//The burst phase moves forward by 1 on each row, so each band starts at the phase the serial blit would be at
+	uint32_t width = _baseFrameInfo.Width;
+	int phase = IsOddFrame() ? 0 : 1;
+
 	if(useHighResOutput) {
-		snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, IsOddFrame() ? 0 : 1, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, baseWidth * 4);
+		GetWorkerPool()->RunRowBands(_baseFrameInfo.Height, [=](uint32_t firstRow, uint32_t endRow) {
+			snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer + firstRow * width, width, (phase + firstRow) % snes_ntsc_burst_count, width, endRow - firstRow, _ntscBuffer + firstRow * baseWidth, baseWidth * 4);
+		});
 		
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
 			memcpy(GetOutputBuffer() + i * frameInfo.Width, _ntscBuffer + yOffset*2 + xOffset + i * baseWidth, frameInfo.Width * sizeof(uint32_t));
 		}
 	} else {
-		snes_ntsc_blit(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, IsOddFrame() ? 0 : 1, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, baseWidth * 4);
+		GetWorkerPool()->RunRowBands(_baseFrameInfo.Height, [=](uint32_t firstRow, uint32_t endRow) {
+			snes_ntsc_blit(&_ntscData, ppuOutputBuffer + firstRow * width, width, (phase + firstRow) % snes_ntsc_burst_count, width, endRow - firstRow, _ntscBuffer + firstRow * baseWidth, baseWidth * 4);
+		});
 
 		for(uint32_t i = 0; i < frameInfo.Height; i += 2) {
 			memcpy(GetOutputBuffer() + i * frameInfo.Width, _ntscBuffer + yOffset + xOffset + i / 2 * baseWidth, frameInfo.Width * sizeof(uint32_t));
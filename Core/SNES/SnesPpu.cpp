@@ -94,9 +94,13 @@ uint16_t SnesPpu::GetScanline()
 }
 
 uint16_t SnesPpu::GetCycle()
+{
+	return GetCycle(_memoryManager->GetHClock());
+}
+
+uint16_t SnesPpu::GetCycle(uint16_t hClock)
 {
 	//"normally dots 323 and 327 are 6 master cycles instead of 4."
-	uint16_t hClock = _memoryManager->GetHClock();
 	if(hClock <= 1292) {
 		return hClock >> 2;
 	} else if(hClock <= 1310) {
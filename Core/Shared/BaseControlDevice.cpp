@@ -230,7 +230,7 @@ void BaseControlDevice::InvertBit(uint8_t bit)
 
 void BaseControlDevice::SetPressedState(uint8_t bit, uint16_t keyCode)
 {
-	if(KeyManager::IsKeyPressed(keyCode)) {
+	if(_emu->GetKeyManager()->IsKeyPressed(keyCode)) {
 		SetBit(bit);
 	}
 }
@@ -157,7 +157,7 @@ void BaseControlManager::ClearDevices()
 
 void BaseControlManager::UpdateInputState()
 {
-	KeyManager::RefreshKeyState();
+	_emu->GetKeyManager()->RefreshKeyState();
 
 	auto lock = _deviceLock.AcquireSafe();
 
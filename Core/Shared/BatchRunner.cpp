@@ -0,0 +1,265 @@
+#include "pch.h"
+#include "Shared/BatchRunner.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/NotificationManager.h"
+#include "Shared/DebuggerRequest.h"
+#include "Shared/Movies/MovieManager.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/ScriptManager.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/HexUtilities.h"
+#include "Utilities/CRC32.h"
+#include "Utilities/magic_enum.hpp"
+
+BatchRunner::BatchRunner(Emulator* emu)
+{
+	_emu = emu;
+	_done = false;
+}
+
+BatchRunResult BatchRunner::Run(BatchRunOptions options)
+{
+	_options = options;
+	_result = {};
+	_done = false;
+	_moviePlaying = false;
+
+	_emu->GetNotificationManager()->RegisterNotificationListener(shared_from_this());
+
+	EmuSettings* settings = _emu->GetSettings();
+	settings->SetFlag(EmulationFlags::ConsoleMode);
+	settings->GetPreferences().DisableGameSelectionScreen = true;
+
+	//Make the power on state deterministic, otherwise hashes can't be compared between runs
+	settings->GetSnesConfig().RamPowerOnState = RamState::AllZeros;
+	settings->GetNesConfig().RamPowerOnState = RamState::AllZeros;
+	settings->GetGameboyConfig().RamPowerOnState = RamState::AllZeros;
+	settings->GetPcEngineConfig().RamPowerOnState = RamState::AllZeros;
+	settings->GetSnesConfig().DisableFrameSkipping = true;
+	settings->GetPcEngineConfig().DisableFrameSkipping = true;
+	settings->GetGbaConfig().DisableFrameSkipping = true;
+
+	settings->GetVideoConfig().VideoFilter = _options.VideoFilter;
+	settings->GetEmulationConfig().RunAheadFrames = _options.RunAheadFrames;
+	settings->GetPreferences().RewindBufferSize = _options.EnableRewind ? PreferencesConfig().RewindBufferSize : 0;
+
+	if(_options.DisableClockScheduler) {
+		settings->SetFlag(EmulationFlags::DisableClockScheduler);
+	} else {
+		settings->ClearFlag(EmulationFlags::DisableClockScheduler);
+	}
+
+	if(_options.BatchCoprocessorSync) {
+		settings->SetFlag(EmulationFlags::BatchCoprocessorSync);
+	} else {
+		settings->ClearFlag(EmulationFlags::BatchCoprocessorSync);
+	}
+
+	_emu->Lock();
+	if(!_emu->LoadRom((VirtualFile)_options.RomFile, (VirtualFile)_options.PatchFile)) {
+		_emu->Unlock();
+		_result.StopReason = BatchStopReason::LoadFailed;
+		return _result;
+	}
+
+	if(!_options.MovieFile.empty()) {
+		_emu->GetMovieManager()->Play((VirtualFile)_options.MovieFile, true);
+		_moviePlaying = _emu->GetMovieManager()->Playing();
+	}
+
+	if(_options.RunAheadFrames == 0) {
+		//Run-ahead is disabled at maximum speed - headless instances are never frame limited, so they still run as fast as possible
+		settings->SetFlag(EmulationFlags::MaximumSpeed);
+	}
+	_timer.Reset();
+	_emu->Unlock();
+
+	if(!_signal.Wait(_options.Timeout)) {
+		_emu->Stop(false, true, false);
+		if(!_done.exchange(true)) {
+			_result.StopReason = BatchStopReason::Timeout;
+			_result.ElapsedMs = _timer.GetElapsedMS();
+		}
+	} else if(_result.StopReason != BatchStopReason::ScriptStop) {
+		//When a script calls emu.stop, the emulator has already been stopped by the time the signal is received
+		_emu->Stop(false, true, false);
+	}
+
+	settings->ClearFlag(EmulationFlags::MaximumSpeed);
+
+	return _result;
+}
+
+void BatchRunner::Finish(BatchStopReason reason)
+{
+	if(_done.exchange(true)) {
+		return;
+	}
+
+	_result.StopReason = reason;
+	_result.StopCode = _emu->GetStopCode();
+	_result.ElapsedMs = _timer.GetElapsedMS();
+
+	PpuFrameInfo frame = _emu->GetPpuFrame();
+	_result.FinalFrameHash = CRC32::GetCRC(frame.FrameBuffer, frame.FrameBufferSize);
+
+	CaptureMemory();
+
+	if(reason != BatchStopReason::ScriptStop) {
+		_signal.Signal();
+	}
+}
+
+void BatchRunner::CaptureFrame()
+{
+	_result.FrameCount++;
+	_result.MasterClock = _emu->GetMasterClock();
+
+	if(_options.RecordFrameHashes) {
+		PpuFrameInfo frame = _emu->GetPpuFrame();
+		_result.FrameHashes.push_back(CRC32::GetCRC(frame.FrameBuffer, frame.FrameBufferSize));
+	}
+}
+
+void BatchRunner::CaptureMemory()
+{
+	for(BatchMemoryRegion& region : _options.MemoryRegions) {
+		ConsoleMemoryInfo memInfo = _emu->GetMemory(region.Type);
+
+		BatchMemoryDump dump = {};
+		dump.Region = region;
+		if(memInfo.Memory && region.Start < memInfo.Size) {
+			uint32_t length = region.Length == 0 ? memInfo.Size - region.Start : std::min(region.Length, memInfo.Size - region.Start);
+			uint8_t* start = (uint8_t*)memInfo.Memory + region.Start;
+			dump.Data.insert(dump.Data.end(), start, start + length);
+		}
+		_result.MemoryDumps.push_back(std::move(dump));
+	}
+}
+
+void BatchRunner::ProcessNotification(ConsoleNotificationType type, void* parameter)
+{
+	switch(type) {
+		case ConsoleNotificationType::GameLoaded:
+			_result.Console = _emu->GetConsoleType();
+			_result.CpuTypes = _emu->GetCpuTypes();
+
+			if(_options.EnableDebugger || !_options.ScriptFile.empty()) {
+				//Start the debugger/load the script before the first frame runs (the emulation thread is paused while GameLoaded is processed)
+				DebuggerRequest dbgRequest = _emu->GetDebugger(true);
+				ifstream file(_options.ScriptFile, ios::in | ios::binary);
+				if(file && dbgRequest.GetDebugger()) {
+					string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+					string name = FolderUtilities::GetFilename(_options.ScriptFile, true);
+					dbgRequest.GetDebugger()->GetScriptManager()->LoadScript(name, _options.ScriptFile, content, -1);
+				}
+			}
+			break;
+
+		case ConsoleNotificationType::PpuFrameDone:
+			if(_done || _emu->IsRunAheadFrame()) {
+				break;
+			}
+
+			CaptureFrame();
+			if(_options.FrameCount > 0 && _result.FrameCount >= _options.FrameCount) {
+				Finish(BatchStopReason::FrameLimit);
+			} else if(_moviePlaying && !_emu->GetMovieManager()->Playing()) {
+				Finish(BatchStopReason::MovieEnded);
+			}
+			break;
+
+		case ConsoleNotificationType::BeforeEmulationStop:
+			//Sent when a script calls emu.stop - the console is still loaded at this point
+			Finish(BatchStopReason::ScriptStop);
+			break;
+
+		case ConsoleNotificationType::EmulationStopped:
+			if(_result.StopReason == BatchStopReason::ScriptStop) {
+				_signal.Signal();
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+string BatchRunner::EscapeJson(string str)
+{
+	string result;
+	for(char c : str) {
+		switch(c) {
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\r': result += "\\r"; break;
+			case '\t': result += "\\t"; break;
+			default:
+				if((uint8_t)c < 0x20) {
+					result += "\\u00" + HexUtilities::ToHex((uint8_t)c);
+				} else {
+					result += c;
+				}
+				break;
+		}
+	}
+	return result;
+}
+
+double BatchRunner::GetFps(BatchRunResult& result)
+{
+	return result.ElapsedMs > 0 ? result.FrameCount * 1000 / result.ElapsedMs : 0;
+}
+
+double BatchRunner::GetCyclesPerSecond(BatchRunResult& result)
+{
+	return result.ElapsedMs > 0 ? result.MasterClock * 1000 / result.ElapsedMs : 0;
+}
+
+void BatchRunner::WriteJson(ostream& out, BatchRunOptions& options, BatchRunResult& result)
+{
+
+	out << "{\n";
+	out << "  \"rom\": \"" << EscapeJson(options.RomFile) << "\",\n";
+	if(!options.MovieFile.empty()) {
+		out << "  \"movie\": \"" << EscapeJson(options.MovieFile) << "\",\n";
+	}
+	if(!options.ScriptFile.empty()) {
+		out << "  \"script\": \"" << EscapeJson(options.ScriptFile) << "\",\n";
+	}
+	out << "  \"console\": \"" << magic_enum::enum_name(result.Console) << "\",\n";
+	out << "  \"stopReason\": \"" << magic_enum::enum_name(result.StopReason) << "\",\n";
+	out << "  \"stopCode\": " << result.StopCode << ",\n";
+	out << "  \"frames\": " << result.FrameCount << ",\n";
+	out << "  \"masterClock\": " << result.MasterClock << ",\n";
+	out << "  \"elapsedMs\": " << std::fixed << std::setprecision(3) << result.ElapsedMs << ",\n";
+	out << "  \"fps\": " << std::fixed << std::setprecision(3) << GetFps(result) << ",\n";
+	out << "  \"cyclesPerSecond\": " << std::fixed << std::setprecision(0) << GetCyclesPerSecond(result) << ",\n";
+	out << "  \"finalFrameHash\": \"" << HexUtilities::ToHex32(result.FinalFrameHash) << "\"";
+
+	if(options.RecordFrameHashes) {
+		out << ",\n  \"frameHashes\": [";
+		for(size_t i = 0; i < result.FrameHashes.size(); i++) {
+			out << (i > 0 ? ", " : "") << "\"" << HexUtilities::ToHex32(result.FrameHashes[i]) << "\"";
+		}
+		out << "]";
+	}
+
+	if(!result.MemoryDumps.empty()) {
+		out << ",\n  \"memory\": [";
+		for(size_t i = 0; i < result.MemoryDumps.size(); i++) {
+			BatchMemoryDump& dump = result.MemoryDumps[i];
+			out << (i > 0 ? "," : "") << "\n    { ";
+			out << "\"type\": \"" << magic_enum::enum_name(dump.Region.Type) << "\", ";
+			out << "\"start\": " << dump.Region.Start << ", ";
+			out << "\"length\": " << dump.Data.size() << ", ";
+			out << "\"data\": \"" << HexUtilities::ToHex(dump.Data) << "\" }";
+		}
+		out << "\n  ]";
+	}
+
+	out << "\n}\n";
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "pch.h"
+#include "Core/Shared/Interfaces/INotificationListener.h"
+#include "Core/Shared/MemoryType.h"
+#include "Core/Shared/CpuType.h"
+#include "Core/Shared/SettingTypes.h"
+#include "Utilities/AutoResetEvent.h"
+#include "Utilities/Timer.h"
+
+class Emulator;
+
+enum class BatchStopReason
+{
+	None,
+	FrameLimit,
+	MovieEnded,
+	ScriptStop,
+	Timeout,
+	LoadFailed
+};
+
+struct BatchMemoryRegion
+{
+	MemoryType Type;
+	uint32_t Start;
+	uint32_t Length; //0 = until the end of the memory type
+};
+
+struct BatchRunOptions
+{
+	string RomFile;
+	string PatchFile;
+	string MovieFile;
+	string ScriptFile;
+
+	//0 = no limit (runs until the movie ends or the script calls emu.stop)
+	uint32_t FrameCount = 0;
+
+	//Wall clock limit, in milliseconds (0 = no limit)
+	uint32_t Timeout = 0;
+
+	bool RecordFrameHashes = false;
+	vector<BatchMemoryRegion> MemoryRegions;
+
+	//Features that affect performance (used by the benchmark)
+	bool EnableDebugger = false;
+	bool EnableRewind = false;
+	uint32_t RunAheadFrames = 0;
+	VideoFilterType VideoFilter = VideoFilterType::None; //Only used when the emulator has a video decoder thread (not headless)
+
+	//Runs the SNES master clock step by step (reference results for the clock scheduler)
+	bool DisableClockScheduler = false;
+	//Syncs the SNES coprocessors in batches instead of on every step
+	bool BatchCoprocessorSync = false;
+};
+
+struct BatchMemoryDump
+{
+	BatchMemoryRegion Region;
+	vector<uint8_t> Data;
+};
+
+struct BatchRunResult
+{
+	BatchStopReason StopReason = BatchStopReason::None;
+	int32_t StopCode = 0;
+	ConsoleType Console = ConsoleType::Snes;
+	vector<CpuType> CpuTypes;
+	uint32_t FrameCount = 0;
+	double ElapsedMs = 0;
+	uint64_t MasterClock = 0;
+	uint32_t FinalFrameHash = 0;
+	vector<uint32_t> FrameHashes;
+	vector<BatchMemoryDump> MemoryDumps;
+};
+
+//Runs a single game at maximum speed without any UI, audio or video output and reports
+//the result (used by the headless command line runner for regression testing)
+class BatchRunner : public INotificationListener, public std::enable_shared_from_this<BatchRunner>
+{
+private:
+	Emulator* _emu = nullptr;
+	BatchRunOptions _options;
+	BatchRunResult _result;
+
+	atomic<bool> _done;
+	bool _moviePlaying = false;
+	AutoResetEvent _signal;
+	Timer _timer;
+
+	void Finish(BatchStopReason reason);
+	void CaptureFrame();
+	void CaptureMemory();
+
+public:
+	BatchRunner(Emulator* emu);
+
+	BatchRunResult Run(BatchRunOptions options);
+
+	void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
+
+	static string EscapeJson(string str);
+	static double GetFps(BatchRunResult& result);
+	static double GetCyclesPerSecond(BatchRunResult& result);
+	static void WriteJson(ostream& out, BatchRunOptions& options, BatchRunResult& result);
+};
@@ -51,6 +51,7 @@
 #include "Shared/EventType.h"
 
 Emulator::Emulator() :
+	_keyManager(new KeyManager(this)),
 	_settings(new EmuSettings(this)),
 	_debugHud(new DebugHud()),
 	_scriptHud(new DebugHud()),
@@ -77,6 +78,10 @@ Emulator::Emulator() :
 	_debugRequestCount = 0;
 	_blockDebuggerRequestCount = 0;
 
+	for(shared_ptr<SerializerSchema>& schema : _stateSchemas) {
+		schema.reset(new SerializerSchema());
+	}
+
 	_videoDecoder->Init();
 }
 
@@ -84,14 +89,25 @@ Emulator::~Emulator()
 {
 }
 
-void Emulator::Initialize(bool enableShortcuts)
+void Emulator::Initialize(bool enableShortcuts, bool headless)
 {
+	_headless = headless;
 	_systemActionManager.reset(new SystemActionManager(this));
 	if(enableShortcuts) {
 		_shortcutKeyHandler.reset(new ShortcutKeyHandler(this));
 		_notificationManager->RegisterNotificationListener(_shortcutKeyHandler);
 	}
 
+	StartVideoThreads();
+}
+
+void Emulator::StartVideoThreads()
+{
+	if(_headless) {
+		//Headless instances never decode or render frames
+		return;
+	}
+
 	_videoDecoder->StartThread();
 	_videoRenderer->StartThread();
 }
@@ -134,8 +150,11 @@ void Emulator::Run()
 	_lastFrameTimer.Reset();
 
 	while(!_stopFlag) {
-		bool useRunAhead = _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_audioPlayerHud && !_rewindManager->IsRewinding() && _settings->GetEmulationSpeed() > 0 && _settings->GetEmulationSpeed() <= 100;
-		if(useRunAhead) {
+		bool useRollback = _gameClient->IsRollbackEnabled();
+		bool useRunAhead = !useRollback && _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_audioPlayerHud && !_rewindManager->IsRewinding() && _settings->GetEmulationSpeed() > 0 && _settings->GetEmulationSpeed() <= 100;
+		if(useRollback) {
+			RunFrameWithRollback();
+		} else if(useRunAhead) {
 			RunFrameWithRunAhead();
 		} else {
 			_console->RunFrame();
@@ -169,6 +188,19 @@ void Emulator::Run()
 	PlatformUtilities::RestoreTimerResolution();
 }
 
+void Emulator::RunFrameWithRollback()
+{
+	//Emulate the frames that used mispredicted netplay input again (no audio/video, like run-ahead frames)
+	_isRunAheadFrame = true;
+	_gameClient->ProcessRollback();
+	_isRunAheadFrame = false;
+
+	_console->RunFrame();
+	_rewindManager->ProcessEndOfFrame();
+	_historyViewer->ProcessEndOfFrame();
+	ProcessSystemActions();
+}
+
 void Emulator::ProcessAutoSaveState()
 {
 	if(_autoSaveStateFrameCounter > 0) {
@@ -204,13 +236,12 @@ bool Emulator::ProcessSystemActions()
 
 void Emulator::RunFrameWithRunAhead()
 {
-	stringstream runAheadState;
 	uint32_t frameCount = _settings->GetEmulationConfig().RunAheadFrames;
 
 	//Run a single frame and save the state (no audio/video)
 	_isRunAheadFrame = true;
 	_console->RunFrame();
-	Serialize(runAheadState, false, 0);
+	SaveSnapshot(_runAheadState, false);
 
 	while(frameCount > 1) {
 		//Run extra frames if the requested run ahead frame count is higher than 1
@@ -228,7 +259,10 @@ void Emulator::RunFrameWithRunAhead()
 	if(!wasReset) {
 		//Load the state we saved earlier
 		_isRunAheadFrame = true;
-		Deserialize(runAheadState, SaveStateManager::FileFormatVersion, false);
+		if(!LoadSnapshot(_runAheadState, false)) {
+			//The layout changed during the run-ahead frames (the current state was restored), keep running from the current state
+			_runAheadState.Clear();
+		}
 		_isRunAheadFrame = false;
 	}
 }
@@ -360,8 +394,7 @@ bool Emulator::LoadRom(VirtualFile romFile, VirtualFile patchFile, bool stopRom,
 	try {
 		return InternalLoadRom(romFile, patchFile, stopRom, forPowerCycle);
 	} catch(std::exception& ex) {
-		_videoDecoder->StartThread();
-		_videoRenderer->StartThread();
+		StartVideoThreads();
 
 		MessageManager::DisplayMessage("Error", "UnexpectedError", ex.what());
 		Stop(false, true, false);
@@ -516,8 +549,7 @@ bool Emulator::InternalLoadRom(VirtualFile romFile, VirtualFile patchFile, bool
 		MessageManager::DisplayMessage(modelName, FolderUtilities::GetFilename(GetRomInfo().RomFile.GetFileName(), false));
 	}
 
-	_videoDecoder->StartThread();
-	_videoRenderer->StartThread();
+	StartVideoThreads();
 
 	if(stopRom) {
 		_stopFlag = false;
@@ -543,6 +575,12 @@ void Emulator::InitConsole(unique_ptr<IConsole>& newConsole, ConsoleMemoryInfo o
 
 	_console.reset(newConsole);
 	_consoleType = _console->GetConsoleType();
+
+	//The state layout depends on the console/rom, the schemas need to be captured again
+	for(shared_ptr<SerializerSchema>& schema : _stateSchemas) {
+		schema.reset(new SerializerSchema());
+	}
+
 	_notificationManager->RegisterNotificationListener(_console.lock());
 }
 
@@ -743,7 +781,8 @@ double Emulator::GetFrameDelay()
 {
 	uint32_t emulationSpeed = _settings->GetEmulationSpeed();
 	double frameDelay;
-	if(emulationSpeed == 0) {
+	if(emulationSpeed == 0 || _headless) {
+		//Headless instances have no audio/video output to stay in sync with
 		frameDelay = 0;
 	} else {
 		frameDelay = 1000 / GetFps();
@@ -939,6 +978,62 @@ bool Emulator::Deserialize(istream& in, uint32_t fileFormatVersion, bool include
 	return true;
 }
 
+void Emulator::SaveSnapshot(StateSnapshot& snapshot, bool includeSettings)
+{
+	shared_ptr<SerializerSchema>& schema = _stateSchemas[includeSettings ? 1 : 0];
+
+	Serializer s(SaveStateManager::FileFormatVersion, true, schema.get(), snapshot._data);
+	if(includeSettings) {
+		SV(_settings);
+	}
+	s.Stream(_console, "");
+	s.SaveTo(snapshot._data);
+
+	if(!s.IsSchemaValid()) {
+		//The state's layout changed since the schema was captured (e.g controllers were changed), capture a new one
+		//Schemas are never modified once captured, since snapshots created with the previous schema may still be in use
+		schema.reset(new SerializerSchema());
+		SaveSnapshot(snapshot, includeSettings);
+		return;
+	}
+
+	snapshot._schema = schema;
+	snapshot._includeSettings = includeSettings;
+}
+
+bool Emulator::InternalLoadSnapshot(StateSnapshot& snapshot)
+{
+	Serializer s(SaveStateManager::FileFormatVersion, false, snapshot._schema.get(), snapshot._data);
+	if(snapshot._includeSettings) {
+		SV(_settings);
+	}
+	s.Stream(_console, "");
+	return s.IsLayoutValid();
+}
+
+bool Emulator::LoadSnapshot(StateSnapshot& snapshot, bool sendNotification)
+{
+	if(!snapshot._schema) {
+		return false;
+	}
+
+	//The layout being loaded is only known once the load is done (e.g the snapshot's settings can change the
+	//controllers), so a load can fail partway through - keep a copy of the current state to restore it when it does
+	SaveSnapshot(_loadSnapshotBackup, snapshot._includeSettings);
+
+	if(!InternalLoadSnapshot(snapshot)) {
+		if(!InternalLoadSnapshot(_loadSnapshotBackup)) {
+			MessageManager::Log("[Emulator] Could not restore the state after a failed snapshot load");
+		}
+		return false;
+	}
+
+	if(sendNotification) {
+		_notificationManager->SendNotification(ConsoleNotificationType::StateLoaded);
+	}
+	return true;
+}
+
 BaseVideoFilter* Emulator::GetVideoFilter(bool getDefaultFilter)
 {
 	shared_ptr<IConsole> console = GetConsole();
@@ -4,6 +4,7 @@
 #include "Core/Debugger/Debugger.h"
 #include "Core/Debugger/DebugUtilities.h"
 #include "Core/Shared/EmulatorLock.h"
+#include "Core/Shared/StateSnapshot.h"
 #include "Core/Shared/Interfaces/IConsole.h"
 #include "Core/Shared/Audio/AudioPlayerTypes.h"
 #include "Utilities/Timer.h"
@@ -30,10 +31,12 @@ class BaseControlManager;
 class VirtualFile;
 class BaseVideoFilter;
 class ShortcutKeyHandler;
+class KeyManager;
 class SystemActionManager;
 class AudioPlayerHud;
 class GameServer;
 class GameClient;
+class SerializerSchema;
 
 class IInputRecorder;
 class IInputProvider;
@@ -69,6 +72,7 @@ private:
 	safe_ptr<Debugger> _debugger;
 	shared_ptr<SystemActionManager> _systemActionManager;
 
+	const unique_ptr<KeyManager> _keyManager;
 	const unique_ptr<EmuSettings> _settings;
 	const unique_ptr<DebugHud> _debugHud;
 	const unique_ptr<DebugHud> _scriptHud;
@@ -103,12 +107,18 @@ private:
 
 	atomic<bool> _isRunAheadFrame;
 	bool _frameRunning = false;
+	bool _headless = false;
+	StateSnapshot _runAheadState;
+	StateSnapshot _loadSnapshotBackup;
 
 	RomInfo _rom;
 	ConsoleType _consoleType = {};
 
 	ConsoleMemoryInfo _consoleMemory[DebugUtilities::GetMemoryTypeCount()] = {};
 
+	//Key layouts for in-memory states (run-ahead, rewind, etc.), indexed by includeSettings
+	shared_ptr<SerializerSchema> _stateSchemas[2];
+
 	unique_ptr<DebugStats> _stats;
 	unique_ptr<FrameLimiter> _frameLimiter;
 	Timer _lastFrameTimer;
@@ -124,6 +134,8 @@ private:
 	void ProcessAutoSaveState();
 	bool ProcessSystemActions();
 	void RunFrameWithRunAhead();
+	void RunFrameWithRollback();
+	bool InternalLoadSnapshot(StateSnapshot& snapshot);
 
 	void BlockDebuggerRequests();
 	void ResetDebugger(bool startDebugger = false);
@@ -135,13 +147,14 @@ private:
 
 	void InitConsole(unique_ptr<IConsole>& newConsole, ConsoleMemoryInfo originalConsoleMemory[], bool preserveRom);
 
+	void StartVideoThreads();
 	bool InternalLoadRom(VirtualFile romFile, VirtualFile patchFile, bool stopRom = true, bool forPowerCycle = false);
 
 public:
 	Emulator();
 	~Emulator();
 
-	void Initialize(bool enableShortcuts = true);
+	void Initialize(bool enableShortcuts = true, bool headless = false);
 	void Release();
 
 	void Run();
@@ -182,11 +195,16 @@ public:
 
 	void Serialize(ostream& out, bool includeSettings, int compressionLevel = 1);
 	bool Deserialize(istream& in, uint32_t fileFormatVersion, bool includeSettings, optional<ConsoleType> consoleType = std::nullopt, bool sendNotification = true);
+	shared_ptr<SerializerSchema> GetStateSchema(bool includeSettings) { return _stateSchemas[includeSettings ? 1 : 0]; }
+
+	void SaveSnapshot(StateSnapshot& snapshot, bool includeSettings);
+	bool LoadSnapshot(StateSnapshot& snapshot, bool sendNotification = true);
 
 	SoundMixer* GetSoundMixer() { return _soundMixer.get(); }
 	VideoRenderer* GetVideoRenderer() { return _videoRenderer.get(); }
 	VideoDecoder* GetVideoDecoder() { return _videoDecoder.get(); }
 	ShortcutKeyHandler* GetShortcutKeyHandler() { return _shortcutKeyHandler.get(); }
+	KeyManager* GetKeyManager() { return _keyManager.get(); }
 	NotificationManager* GetNotificationManager() { return _notificationManager.get(); }
 	EmuSettings* GetSettings() { return _settings.get(); }
 	SaveStateManager* GetSaveStateManager() { return _saveStateManager.get(); }
@@ -230,6 +248,7 @@ public:
 
 	bool IsRunning() { return _console != nullptr; }
 	bool IsRunAheadFrame() { return _isRunAheadFrame; }
+	bool IsHeadless() { return _headless; }
 
 	TimingInfo GetTimingInfo(CpuType cpuType);
 	uint32_t GetFrameCount();
@@ -6,12 +6,10 @@
 #include "Shared/Video/VideoDecoder.h"
 #include "Shared/Video/VideoRenderer.h"
 
-IKeyManager* KeyManager::_keyManager = nullptr;
-MousePosition KeyManager::_mousePosition = { 0, 0 };
-double KeyManager::_xMouseMovement;
-double KeyManager::_yMouseMovement;
-EmuSettings* KeyManager::_settings = nullptr;
-SimpleLock KeyManager::_lock;
+KeyManager::KeyManager(Emulator* emu)
+{
+	_emu = emu;
+}
 
 void KeyManager::RegisterKeyManager(IKeyManager* keyManager)
 {
@@ -27,15 +25,10 @@ void KeyManager::RefreshKeyState()
 	}
 }
 
-void KeyManager::SetSettings(EmuSettings *settings)
-{
-	_settings = settings;
-}
-
 bool KeyManager::IsKeyPressed(uint16_t keyCode)
 {
 	if(_keyManager != nullptr) {
-		return _settings->IsInputEnabled() && _keyManager->IsKeyPressed(keyCode);
+		return _emu->GetSettings()->IsInputEnabled() && _keyManager->IsKeyPressed(keyCode);
 	}
 	return false;
 }
@@ -43,7 +36,7 @@ bool KeyManager::IsKeyPressed(uint16_t keyCode)
 bool KeyManager::IsMouseButtonPressed(MouseButton button)
 {
 	if(_keyManager != nullptr) {
-		return _settings->IsInputEnabled() && _keyManager->IsMouseButtonPressed(button);
+		return _emu->GetSettings()->IsInputEnabled() && _keyManager->IsMouseButtonPressed(button);
 	}
 	return false;
 }
@@ -86,11 +79,11 @@ void KeyManager::SetMouseMovement(int16_t x, int16_t y)
 	_yMouseMovement += y;
 }
 
-MouseMovement KeyManager::GetMouseMovement(Emulator* emu, uint32_t mouseSensitivity)
+MouseMovement KeyManager::GetMouseMovement(uint32_t mouseSensitivity)
 {
 	constexpr double divider[10] = { 0.25, 0.33, 0.5, 0.66, 0.75, 1, 1.5, 2, 3, 4 };
-	FrameInfo rendererSize = emu->GetVideoRenderer()->GetRendererSize();
-	FrameInfo frameSize = emu->GetVideoDecoder()->GetFrameInfo();
+	FrameInfo rendererSize = _emu->GetVideoRenderer()->GetRendererSize();
+	FrameInfo frameSize = _emu->GetVideoDecoder()->GetFrameInfo();
 	double scale = (double)rendererSize.Width / frameSize.Width;
 	double factor = scale / divider[mouseSensitivity];
 
@@ -105,7 +98,7 @@ MouseMovement KeyManager::GetMouseMovement(Emulator* emu, uint32_t mouseSensitiv
 	return mov;
 }
 
-void KeyManager::SetMousePosition(Emulator* emu, double x, double y)
+void KeyManager::SetMousePosition(double x, double y)
 {
 	if(x < 0 || y < 0) {
 		_mousePosition.X = -1;
@@ -113,8 +106,8 @@ void KeyManager::SetMousePosition(Emulator* emu, double x, double y)
 		_mousePosition.RelativeX = -1;
 		_mousePosition.RelativeY = -1;
 	} else {
-		OverscanDimensions overscan = emu->GetSettings()->GetOverscan();
-		FrameInfo frame = emu->GetVideoDecoder()->GetBaseFrameInfo(true);
+		OverscanDimensions overscan = _emu->GetSettings()->GetOverscan();
+		FrameInfo frame = _emu->GetVideoDecoder()->GetBaseFrameInfo(true);
 		_mousePosition.X = (int32_t)(x*frame.Width + overscan.Left);
 		_mousePosition.Y = (int32_t)(y*frame.Height + overscan.Top);
 		_mousePosition.RelativeX = x;
@@ -4,34 +4,34 @@
 #include "Utilities/SimpleLock.h"
 
 class Emulator;
-class EmuSettings;
 
 class KeyManager
 {
 private:
-	static IKeyManager* _keyManager;
-	static MousePosition _mousePosition;
-	static double _xMouseMovement;
-	static double _yMouseMovement;
-	static EmuSettings* _settings;
-	static SimpleLock _lock;
+	Emulator* _emu = nullptr;
+	IKeyManager* _keyManager = nullptr;
+	MousePosition _mousePosition = {};
+	double _xMouseMovement = 0;
+	double _yMouseMovement = 0;
+	SimpleLock _lock;
 
 public:
-	static void RegisterKeyManager(IKeyManager* keyManager);
-	static void SetSettings(EmuSettings* settings);
+	KeyManager(Emulator* emu);
 
-	static void RefreshKeyState();
-	static bool IsKeyPressed(uint16_t keyCode);
-	static bool IsMouseButtonPressed(MouseButton button);
-	static vector<uint16_t> GetPressedKeys();
-	static string GetKeyName(uint16_t keyCode);
-	static uint16_t GetKeyCode(string keyName);
+	void RegisterKeyManager(IKeyManager* keyManager);
 
-	static void UpdateDevices();
+	void RefreshKeyState();
+	bool IsKeyPressed(uint16_t keyCode);
+	bool IsMouseButtonPressed(MouseButton button);
+	vector<uint16_t> GetPressedKeys();
+	string GetKeyName(uint16_t keyCode);
+	uint16_t GetKeyCode(string keyName);
+
+	void UpdateDevices();
 	
-	static void SetMouseMovement(int16_t x, int16_t y);
-	static MouseMovement GetMouseMovement(Emulator* emu, uint32_t mouseSensitivity);
+	void SetMouseMovement(int16_t x, int16_t y);
+	MouseMovement GetMouseMovement(uint32_t mouseSensitivity);
 	
-	static void SetMousePosition(Emulator* emu, double x, double y);
-	static MousePosition GetMousePosition();
-};
\ No newline at end of file
+	void SetMousePosition(double x, double y);
+	MousePosition GetMousePosition();
+};
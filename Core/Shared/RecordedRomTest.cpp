@@ -62,6 +62,7 @@ void RecordedRomTest::ValidateFrame()
 		_screenshotHashes.pop_front();
 	}
 	_currentCount--;
+	_frameCount++;
 
 	if(memcmp(_screenshotHashes.front(), md5Hash, 16) != 0) {
 		_badFrameCount++;
@@ -109,6 +110,7 @@ void RecordedRomTest::Reset()
 	_runningTest = false;
 	_recording = false;
 	_badFrameCount = 0;
+	_frameCount = 0;
 }
 
 void RecordedRomTest::Record(string filename, bool reset)
@@ -30,6 +30,7 @@ private:
 	bool _recording = false;
 	bool _runningTest = false;
 	int _badFrameCount = 0;
+	uint32_t _frameCount = 0;
 	bool _isLastFrameGood = false;
 
 	uint8_t _previousHash[16] = {};
@@ -55,5 +56,6 @@ public:
 	void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
 	void Record(string filename, bool reset);
 	RomTestResult Run(string filename);
+	uint32_t GetFrameCount() { return _frameCount; }
 	void Stop();
 };
\ No newline at end of file
@@ -2,79 +2,169 @@
 #include "Shared/RewindData.h"
 #include "Shared/Emulator.h"
 #include "Shared/SaveStateManager.h"
+#include "Shared/StateSnapshot.h"
 #include "Utilities/CompressionHelper.h"
+#include "Utilities/Serializer.h"
 
-void RewindData::GetStateData(stringstream &stateData, deque<RewindData>& prevStates, int32_t position)
+RewindStateData::RewindStateData(vector<uint8_t>&& data)
 {
-	vector<uint8_t> data;
-	CompressionHelper::Decompress(_saveStateData, data);
+	_data = std::move(data);
+	_isCompressed = false;
+}
+
+void RewindStateData::Compress()
+{
+	if(_isCompressed) {
+		return;
+	}
+
+	//Only this thread can modify the data, so it can be read without holding the lock
+	vector<uint8_t> compressedData;
+	CompressionHelper::Compress(_data.data(), (uint32_t)_data.size(), 1, compressedData, CompressionCodec::Lz4);
+
+	auto lock = _lock.AcquireSafe();
+	_data = std::move(compressedData);
+	_isCompressed = true;
+}
 
-	if(!IsFullState) {
-		position = (position > 0 ? position : (int32_t)prevStates.size()) - 1;
-		ProcessXorState(data, prevStates, position);
+bool RewindStateData::GetData(vector<uint8_t>& out)
+{
+	auto lock = _lock.AcquireSafe();
+	if(_isCompressed) {
+		return CompressionHelper::Decompress(_data, out);
+	} else {
+		out = _data;
+		return true;
 	}
+}
+
+uint32_t RewindStateData::GetSize()
+{
+	auto lock = _lock.AcquireSafe();
+	return (uint32_t)_data.size();
+}
 
-	stateData.write((char*)data.data(), data.size());
+void RewindData::GetStateData(stringstream &stateData, deque<RewindData>& prevStates, int32_t position)
+{
+	vector<uint8_t> data;
+	if(GetState(data, prevStates, position)) {
+		//Rewind states are in the schema format, convert them back to the regular format
+		Serializer::ConvertSchemaData(*_schema, data, stateData);
+	}
 }
 
-template<typename T>
-void RewindData::ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t position)
+RewindData* RewindData::GetFullState(deque<RewindData>& prevStates, int32_t position)
 {
-	//Find last full state and XOR with it
-	while(position >= 0 && position < prevStates.size()) {
+	//Find last full state
+	while(position >= 0 && position < (int32_t)prevStates.size()) {
 		RewindData& prevState = prevStates[position];
 		if(prevState.IsFullState) {
-			//XOR with previous state to restore state data to its initial state
-			if(!prevState._uncompressedData.empty()) {
-				for(size_t i = 0, len = std::min(prevState._uncompressedData.size(), data.size()); i < len; i++) {
-					data[i] ^= prevState._uncompressedData[i];
-				}
-			} else {
-				vector<uint8_t> prevStateData;
-				CompressionHelper::Decompress(prevState._saveStateData, prevStateData);
-				for(size_t i = 0, len = std::min(prevStateData.size(), data.size()); i < len; i++) {
-					data[i] ^= prevStateData[i];
-				}
-			}
-			break;
+			return &prevState;
 		}
 		position--;
 	}
+	return nullptr;
+}
+
+bool RewindData::GetState(vector<uint8_t>& data, deque<RewindData>& prevStates, int32_t position)
+{
+	if(!_stateData) {
+		return false;
+	}
+
+	if(IsFullState) {
+		if(!_uncompressedData.empty()) {
+			data = _uncompressedData;
+			return true;
+		}
+		return _stateData->GetData(data);
+	}
+
+	position = (position > 0 ? position : (int32_t)prevStates.size()) - 1;
+	RewindData* fullState = GetFullState(prevStates, position);
+	if(!fullState || !fullState->GetState(data, prevStates, position)) {
+		return false;
+	}
+
+	vector<uint8_t> pages;
+	if(!_stateData->GetData(pages)) {
+		return false;
+	}
+
+	//Start from the full state and overwrite the pages that were modified since then
+	data.resize(_stateSize, 0);
+	for(size_t i = 0; i + sizeof(uint32_t) <= pages.size();) {
+		uint32_t offset;
+		memcpy(&offset, pages.data() + i, sizeof(uint32_t));
+		i += sizeof(uint32_t);
+
+		if(offset >= _stateSize) {
+			return false;
+		}
+
+		uint32_t size = std::min(RewindData::PageSize, _stateSize - offset);
+		if(i + size > pages.size()) {
+			return false;
+		}
+		memcpy(data.data() + offset, pages.data() + i, size);
+		i += size;
+	}
+	return true;
 }
 
 void RewindData::LoadState(Emulator* emu, deque<RewindData>& prevStates, int32_t position, bool sendNotification)
 {
-	if(_saveStateData.size() == 0) {
+	vector<uint8_t> data;
+	if(!GetState(data, prevStates, position)) {
 		return;
 	}
-		
-	vector<uint8_t> data;
-	CompressionHelper::Decompress(_saveStateData, data);
 
-	if(!IsFullState) {
-		position = (position > 0 ? position : (int32_t)prevStates.size()) - 1;
-		ProcessXorState(data, prevStates, position);
+	if(emu->GetStateSchema(true) == _schema) {
+		StateSnapshot snapshot(std::move(data), _schema, true);
+		if(emu->LoadSnapshot(snapshot, sendNotification)) {
+			return;
+		}
+		data = std::move(snapshot.GetData());
 	}
 
+	//State was created by another instance (history viewer), with a previous schema, or the layout
+	//no longer matches the schema: convert it back to the regular format, which is loaded by key
 	stringstream stream;
-	stream.write((char*)data.data(), data.size());
+	Serializer::ConvertSchemaData(*_schema, data, stream);
 	stream.seekg(0, ios::beg);
-
 	emu->Deserialize(stream, SaveStateManager::FileFormatVersion, true, std::nullopt, sendNotification);
 }
 
-void RewindData::SaveState(Emulator* emu, deque<RewindData>& prevStates, int32_t position)
+void RewindData::SaveState(Emulator* emu, deque<RewindData>& prevStates, StateSnapshot& snapshot, int32_t position)
 {
-	std::stringstream state;
-	emu->Serialize(state, true, 0);
+	//The state is left uncompressed, RewindManager compresses it on its compression thread
+	emu->SaveSnapshot(snapshot, true);
+	_schema = snapshot.GetSchema();
 
-	string data = state.str();
+	vector<uint8_t>& data = snapshot.GetData();
+	_stateSize = (uint32_t)data.size();
 
 	position = position > 0 ? position : (int32_t)prevStates.size();
 
+	RewindData* fullState = nullptr;
 	if(position > 0 && (position % 30) != 0) {
-		position--;
-		ProcessXorState(data, prevStates, position);
+		fullState = GetFullState(prevStates, position - 1);
+	}
+
+	if(fullState && !fullState->_uncompressedData.empty()) {
+		//Only keep the pages that changed since the last full state
+		vector<uint8_t>& fullData = fullState->_uncompressedData;
+		vector<uint8_t> pages;
+		for(uint32_t offset = 0; offset < _stateSize; offset += RewindData::PageSize) {
+			uint32_t size = std::min(RewindData::PageSize, _stateSize - offset);
+			if(offset + size <= fullData.size() && memcmp(data.data() + offset, fullData.data() + offset, size) == 0) {
+				_savedBytes += size;
+				continue;
+			}
+			pages.insert(pages.end(), (uint8_t*)&offset, (uint8_t*)&offset + sizeof(uint32_t));
+			pages.insert(pages.end(), data.data() + offset, data.data() + offset + size);
+		}
+		_stateData.reset(new RewindStateData(std::move(pages)));
 	} else {
 		IsFullState = true;
 		while(position > 0) {
@@ -88,9 +178,9 @@ void RewindData::SaveState(Emulator* emu, deque<RewindData>& prevStates, int32_t
 		}
 
 		//Keep uncompressed data for the next 30 states - this avoids having to decompress the state 30 times
-		_uncompressedData = vector<uint8_t>(data.begin(), data.end());
+		_uncompressedData = data;
+		_stateData.reset(new RewindStateData(vector<uint8_t>(data)));
 	}
 
-	CompressionHelper::Compress(data, 1, _saveStateData);
 	FrameCount = 0;
 }
@@ -2,17 +2,45 @@
 #include "pch.h"
 #include <deque>
 #include "Shared/BaseControlDevice.h"
+#include "Utilities/SimpleLock.h"
 
 class Emulator;
+class SerializerSchema;
+class StateSnapshot;
+
+//State data for a rewind entry - the data is compressed by RewindManager's compression thread
+//and can be used at any time (the uncompressed data is used until compression is done)
+class RewindStateData
+{
+private:
+	SimpleLock _lock;
+	vector<uint8_t> _data;
+	atomic<bool> _isCompressed;
+
+public:
+	RewindStateData(vector<uint8_t>&& data);
+
+	void Compress();
+	bool GetData(vector<uint8_t>& out);
+	uint32_t GetSize();
+	bool IsCompressed() { return _isCompressed; }
+};
 
 class RewindData
 {
+public:
+	//Size of the pages compared against the last full state - only the pages that changed are stored for other states
+	static constexpr uint32_t PageSize = 0x400;
+
 private:
-	vector<uint8_t> _saveStateData;
+	shared_ptr<RewindStateData> _stateData;
 	vector<uint8_t> _uncompressedData;
+	shared_ptr<SerializerSchema> _schema;
+	uint32_t _stateSize = 0;
+	uint32_t _savedBytes = 0;
 
-	template<typename T>
-	void ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t position);
+	RewindData* GetFullState(deque<RewindData>& prevStates, int32_t position);
+	bool GetState(vector<uint8_t>& data, deque<RewindData>& prevStates, int32_t position);
 
 public:
 	std::deque<ControlDeviceState> InputLogs[BaseControlDevice::PortCount];
@@ -21,8 +49,10 @@ public:
 	bool IsFullState = false;
 
 	void GetStateData(stringstream& stateData, deque<RewindData>& prevStates, int32_t position);
-	uint32_t GetStateSize() { return (uint32_t)_saveStateData.size(); }
+	uint32_t GetStateSize() { return _stateData ? _stateData->GetSize() : 0; }
+	shared_ptr<RewindStateData> GetPendingStateData() { return _stateData && !_stateData->IsCompressed() ? _stateData : nullptr; }
+	uint32_t GetSavedBytes() { return _savedBytes; }
 
 	void LoadState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1, bool sendNotification = true);
-	void SaveState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1);
+	void SaveState(Emulator* emu, deque<RewindData>& prevStates, StateSnapshot& snapshot, int32_t position = -1);
 };
@@ -13,10 +13,12 @@ RewindManager::RewindManager(Emulator* emu)
 {
 	_emu = emu;
 	_settings = emu->GetSettings();
+	_stopCompression = false;
 }
 
 RewindManager::~RewindManager()
 {
+	StopCompressionThread();
 	_settings->ClearFlag(EmulationFlags::MaximumSpeed);
 	_settings->ClearFlag(EmulationFlags::Rewind);
 	_emu->UnregisterInputProvider(this);
@@ -52,6 +54,62 @@ void RewindManager::ClearBuffer()
 	_audioHistoryBuilder.clear();
 	_rewindState = RewindState::Stopped;
 	_currentHistory = {};
+
+	auto lock = _compressionLock.AcquireSafe();
+	_compressionQueue.clear();
+}
+
+void RewindManager::QueueCompression(shared_ptr<RewindStateData> stateData)
+{
+	if(!_compressionThread) {
+		_stopCompression = false;
+		_compressionThread.reset(new thread(&RewindManager::CompressionThread, this));
+	}
+
+	{
+		auto lock = _compressionLock.AcquireSafe();
+		if(_compressionQueue.size() < RewindManager::MaxPendingCompressions) {
+			_compressionQueue.push_back(stateData);
+			stateData.reset();
+		}
+	}
+
+	if(stateData) {
+		//Compression thread can't keep up, compress on the emulation thread to keep memory usage in check
+		stateData->Compress();
+	} else {
+		_compressionSignal.Signal();
+	}
+}
+
+void RewindManager::CompressionThread()
+{
+	while(!_stopCompression) {
+		shared_ptr<RewindStateData> stateData;
+		{
+			auto lock = _compressionLock.AcquireSafe();
+			if(!_compressionQueue.empty()) {
+				stateData = _compressionQueue.front();
+				_compressionQueue.pop_front();
+			}
+		}
+
+		if(stateData) {
+			stateData->Compress();
+		} else {
+			_compressionSignal.Wait();
+		}
+	}
+}
+
+void RewindManager::StopCompressionThread()
+{
+	if(_compressionThread) {
+		_stopCompression = true;
+		_compressionSignal.Signal();
+		_compressionThread->join();
+		_compressionThread.reset();
+	}
 }
 
 void RewindManager::ProcessNotification(ConsoleNotificationType type, void * parameter)
@@ -107,12 +165,15 @@ void RewindManager::ProcessNotification(ConsoleNotificationType type, void * par
 RewindStats RewindManager::GetStats()
 {
 	uint32_t memoryUsage = 0;
+	uint64_t savedBytes = 0;
 	for(int i = (int)_history.size() - 1; i >= 0; i--) {
 		memoryUsage += _history[i].GetStateSize();
+		savedBytes += _history[i].GetSavedBytes();
 	}
 	
 	RewindStats stats = {};
 	stats.MemoryUsage = memoryUsage;
+	stats.SavedBytes = savedBytes;
 	stats.HistorySize = (uint32_t)_history.size();
 	stats.HistoryDuration = stats.HistorySize * RewindManager::BufferSize;
 	return stats;
@@ -143,7 +204,12 @@ void RewindManager::AddHistoryBlock()
 			_history.push_back(_currentHistory);
 		}
 		_currentHistory = RewindData();
-		_currentHistory.SaveState(_emu, _history);
+		_currentHistory.SaveState(_emu, _history, _snapshot);
+
+		shared_ptr<RewindStateData> stateData = _currentHistory.GetPendingStateData();
+		if(stateData) {
+			QueueCompression(stateData);
+		}
 	}
 }
 
@@ -3,8 +3,11 @@
 #include <deque>
 #include "Shared/Interfaces/INotificationListener.h"
 #include "Shared/RewindData.h"
+#include "Shared/StateSnapshot.h"
 #include "Shared/Interfaces/IInputProvider.h"
 #include "Shared/Interfaces/IInputRecorder.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
 
 class Emulator;
 class EmuSettings;
@@ -34,12 +37,14 @@ struct RewindStats
 	uint32_t MemoryUsage;
 	uint32_t HistorySize;
 	uint32_t HistoryDuration;
+	uint64_t SavedBytes; //Size of the unchanged pages that were not stored
 };
 
 class RewindManager : public INotificationListener, public IInputProvider, public IInputRecorder
 {
 public:
 	static constexpr int32_t BufferSize = 30; //Number of frames between each save state
+	static constexpr int32_t MaxPendingCompressions = 8; //States are compressed on the emulation thread when the queue is full
 
 private:
 	Emulator* _emu = nullptr;
@@ -50,6 +55,7 @@ private:
 	deque<RewindData> _history;
 	deque<RewindData> _historyBackup;
 	RewindData _currentHistory = {};
+	StateSnapshot _snapshot;
 
 	RewindState _rewindState = RewindState::Stopped;
 	int32_t _framesToFastForward = 0;
@@ -59,6 +65,16 @@ private:
 	deque<int16_t> _audioHistory;
 	vector<int16_t> _audioHistoryBuilder;
 
+	unique_ptr<thread> _compressionThread;
+	deque<shared_ptr<RewindStateData>> _compressionQueue;
+	SimpleLock _compressionLock;
+	AutoResetEvent _compressionSignal;
+	atomic<bool> _stopCompression;
+
+	void QueueCompression(shared_ptr<RewindStateData> stateData);
+	void CompressionThread();
+	void StopCompressionThread();
+
 	void AddHistoryBlock();
 	void PopHistory();
 
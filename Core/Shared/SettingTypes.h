@@ -10,6 +10,13 @@ enum class EmulationFlags
 	MaximumSpeed = 0x04,
 	InBackground = 0x08,
 	ConsoleMode = 0x10,
+
+	//Runs the SNES master clock 2 clocks at a time, without skipping ahead to the next event (reference results used to validate the clock scheduler)
+	DisableClockScheduler = 0x20,
+
+	//Experimental: lets the SNES coprocessors run behind the main CPU and catch up in batches, instead of syncing them
+	//on every step (not validated against the per-step sync yet, ignored when DisableClockScheduler is set)
+	BatchCoprocessorSync = 0x40,
 };
 
 enum class ScaleFilterType
@@ -118,6 +125,7 @@ struct VideoConfig
 	uint32_t FullscreenResHeight = 0;
 
 	uint32_t ScreenRotation = 0;
+	uint32_t FilterThreadCount = 0;
 };
 
 struct AudioConfig
@@ -73,10 +73,10 @@ bool ShortcutKeyHandler::IsKeyPressed(uint16_t keyCode, bool mergeCtrlAltShift)
 	if(keyCode >= 116 && keyCode <= 121 && mergeCtrlAltShift) {
 		//Left/right ctrl/alt/shift
 		//Return true if either the left or right key is pressed
-		return KeyManager::IsKeyPressed(keyCode | 1) || KeyManager::IsKeyPressed(keyCode & ~0x01);
+		return _emu->GetKeyManager()->IsKeyPressed(keyCode | 1) || _emu->GetKeyManager()->IsKeyPressed(keyCode & ~0x01);
 	}
 
-	return KeyManager::IsKeyPressed(keyCode);
+	return _emu->GetKeyManager()->IsKeyPressed(keyCode);
 }
 
 bool ShortcutKeyHandler::DetectKeyPress(EmulatorShortcut shortcut)
@@ -331,9 +331,9 @@ void ShortcutKeyHandler::ProcessKeys()
 	}
 
 	auto lock = _lock.AcquireSafe();
-	KeyManager::RefreshKeyState();
+	_emu->GetKeyManager()->RefreshKeyState();
 
-	_pressedKeys = KeyManager::GetPressedKeys();
+	_pressedKeys = _emu->GetKeyManager()->GetPressedKeys();
 	_isKeyUp = _pressedKeys.size() < _lastPressedKeys.size();
 
 	bool noChange = false;
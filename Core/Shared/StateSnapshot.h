@@ -0,0 +1,38 @@
+#pragma once
+#include "pch.h"
+
+class SerializerSchema;
+
+//Reusable in-memory save state, used by run-ahead, rewind and step back (see Emulator::SaveSnapshot)
+//Values are stored without keys or compression, and the buffer's capacity is kept
+//between snapshots, so taking a snapshot does not allocate any memory once warmed up.
+class StateSnapshot
+{
+private:
+	friend class Emulator;
+
+	vector<uint8_t> _data;
+	shared_ptr<SerializerSchema> _schema;
+	bool _includeSettings = false;
+
+public:
+	StateSnapshot() {}
+	
+	StateSnapshot(vector<uint8_t>&& data, shared_ptr<SerializerSchema> schema, bool includeSettings)
+	{
+		_data = std::move(data);
+		_schema = schema;
+		_includeSettings = includeSettings;
+	}
+
+	bool IsValid() { return _schema != nullptr; }
+	vector<uint8_t>& GetData() { return _data; }
+	shared_ptr<SerializerSchema> GetSchema() { return _schema; }
+
+	void Clear()
+	{
+		//Keep the buffer's capacity, to be able to reuse it
+		_data.clear();
+		_schema.reset();
+	}
+};
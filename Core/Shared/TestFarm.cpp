@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "Shared/TestFarm.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Utilities/Timer.h"
+#include "Utilities/magic_enum.hpp"
+
+uint32_t TestFarm::GetDefaultThreadCount()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+template<typename TJob, typename TResult>
+void TestFarm::RunJobs(vector<TJob>& jobs, vector<TResult>& results, uint32_t threadCount, std::function<TResult(Emulator*, TJob&)> runJob)
+{
+	results.resize(jobs.size());
+
+	if(threadCount == 0) {
+		threadCount = GetDefaultThreadCount();
+	}
+	threadCount = std::min(threadCount, (uint32_t)jobs.size());
+
+	atomic<uint32_t> nextJob(0);
+	auto worker = [&]() {
+		uint32_t index;
+		while((index = nextJob++) < jobs.size()) {
+			//Use a new instance for each job, to make sure the results don't depend on the order the jobs run in
+			unique_ptr<Emulator> emu(new Emulator());
+			emu->Initialize(false, true);
+			emu->GetSettings()->SetFlag(EmulationFlags::ConsoleMode);
+
+			results[index] = runJob(emu.get(), jobs[index]);
+
+			emu->Release();
+		}
+	};
+
+	vector<unique_ptr<thread>> workers;
+	for(uint32_t i = 0; i < threadCount; i++) {
+		workers.push_back(unique_ptr<thread>(new thread(worker)));
+	}
+	for(unique_ptr<thread>& t : workers) {
+		t->join();
+	}
+}
+
+vector<TestFarmResult> TestFarm::RunRecordedTests(vector<string> testFiles, uint32_t threadCount)
+{
+	vector<TestFarmResult> results;
+	RunJobs<string, TestFarmResult>(testFiles, results, threadCount, [](Emulator* emu, string& testFile) {
+		TestFarmResult result = {};
+		result.Filename = testFile;
+
+		Timer timer;
+		shared_ptr<RecordedRomTest> romTest(new RecordedRomTest(emu, true));
+		result.Result = romTest->Run(testFile);
+		result.ElapsedMs = timer.GetElapsedMS();
+		result.FrameCount = romTest->GetFrameCount();
+		result.Fps = result.ElapsedMs > 0 ? result.FrameCount * 1000 / result.ElapsedMs : 0;
+		return result;
+	});
+	return results;
+}
+
+vector<BatchRunResult> TestFarm::RunBatch(vector<BatchRunOptions> jobs, uint32_t threadCount)
+{
+	vector<BatchRunResult> results;
+	RunJobs<BatchRunOptions, BatchRunResult>(jobs, results, threadCount, [](Emulator* emu, BatchRunOptions& options) {
+		shared_ptr<BatchRunner> runner(new BatchRunner(emu));
+		return runner->Run(options);
+	});
+	return results;
+}
+
+void TestFarm::WriteJson(ostream& out, TestFarmResult& result)
+{
+	out << "{\n";
+	out << "  \"test\": \"" << BatchRunner::EscapeJson(result.Filename) << "\",\n";
+	out << "  \"state\": \"" << magic_enum::enum_name(result.Result.State) << "\",\n";
+	out << "  \"errorCode\": " << result.Result.ErrorCode << ",\n";
+	out << "  \"frames\": " << result.FrameCount << ",\n";
+	out << "  \"elapsedMs\": " << std::fixed << std::setprecision(3) << result.ElapsedMs << ",\n";
+	out << "  \"fps\": " << std::fixed << std::setprecision(3) << result.Fps << "\n";
+	out << "}\n";
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "pch.h"
+#include <functional>
+#include "Core/Shared/RecordedRomTest.h"
+#include "Core/Shared/BatchRunner.h"
+
+struct TestFarmResult
+{
+	string Filename;
+	RomTestResult Result;
+	uint32_t FrameCount;
+	double ElapsedMs;
+	double Fps;
+};
+
+//Runs many tests in parallel - each test gets its own headless emulator instance (no video/audio threads),
+//and tests are distributed over a pool of worker threads
+class TestFarm
+{
+private:
+	template<typename TJob, typename TResult>
+	static void RunJobs(vector<TJob>& jobs, vector<TResult>& results, uint32_t threadCount, std::function<TResult(Emulator*, TJob&)> runJob);
+
+public:
+	static uint32_t GetDefaultThreadCount();
+
+	static vector<TestFarmResult> RunRecordedTests(vector<string> testFiles, uint32_t threadCount = 0);
+	static vector<BatchRunResult> RunBatch(vector<BatchRunOptions> jobs, uint32_t threadCount = 0);
+
+	static void WriteJson(ostream& out, TestFarmResult& result);
+};
@@ -78,6 +78,13 @@ uint32_t BaseVideoFilter::GetBufferSize()
 	return _bufferSize * sizeof(uint32_t);
 }
 
+WorkerPool* BaseVideoFilter::GetWorkerPool()
+{
+	//Created on first use, so filters that don't need it don't start any threads
+	WorkerPool::Update(_workerPool, _emu->GetSettings()->GetVideoConfig().FilterThreadCount);
+	return _workerPool.get();
+}
+
 FrameInfo BaseVideoFilter::GetFrameInfo(uint16_t* ppuOutputBuffer, bool enableOverscan)
 {
 	_overscan = enableOverscan ? _emu->GetSettings()->GetOverscan() : OverscanDimensions {};
@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include "Utilities/SimpleLock.h"
+#include "Utilities/WorkerPool.h"
 #include "Shared/SettingTypes.h"
 
 class Emulator;
@@ -15,6 +16,7 @@ private:
 	OverscanDimensions _overscan = {};
 	bool _isOddFrame = false;
 	uint32_t _videoPhase = 0;
+	unique_ptr<WorkerPool> _workerPool;
 
 	void UpdateBufferSize();
 
@@ -36,6 +38,9 @@ protected:
 	uint32_t GetVideoPhase();
 	uint32_t GetBufferSize();
 
+	//Worker pool used by filters to process the frame in bands of rows
+	WorkerPool* GetWorkerPool();
+
 protected:
 	virtual FrameInfo GetFrameInfo();
 
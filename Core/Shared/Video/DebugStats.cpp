@@ -87,8 +87,8 @@ void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 		hud->DrawLine(130 + i*2, 60 + 50 - duration*2, 130 + i*2 + 2, 60 + 50 - nextDuration*2, lineColor, 1, startFrame);
 	}
 
-	hud->DrawRectangle(8, 60, 115, 34, 0x40000000, true, 1, startFrame);
-	hud->DrawRectangle(8, 60, 115, 34, 0xFFFFFF, false, 1, startFrame);
+	hud->DrawRectangle(8, 60, 115, 43, 0x40000000, true, 1, startFrame);
+	hud->DrawRectangle(8, 60, 115, 43, 0xFFFFFF, false, 1, startFrame);
 
 	hud->DrawString(10, 62, "Misc. Stats", 0xFFFFFF, 0xFF000000, 1, startFrame);
 
@@ -103,4 +103,8 @@ void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 		ss << "   Per min.: " << std::fixed << std::setprecision(2) << (memUsage * 60 * 60 / rewindStats.HistoryDuration) << " MB";
 		hud->DrawString(9, 82, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
 	}
+
+	ss = std::stringstream();
+	ss << "Rewind saved: " << std::fixed << std::setprecision(2) << ((double)rewindStats.SavedBytes / (1024 * 1024)) << " MB";
+	hud->DrawString(10, 91, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
 }
@@ -3,6 +3,7 @@
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/ColorUtilities.h"
+#include "Utilities/WorkerPool.h"
 #include "Utilities/NTSC/snes_ntsc.h"
 #include "Utilities/NTSC/sms_ntsc.h"
 
@@ -87,7 +88,7 @@ public:
 		}
 	}
 
-	void ApplyFilter(uint32_t* inOut, uint32_t inWidth, uint32_t inHeight, int phase)
+	void ApplyFilter(uint32_t* inOut, uint32_t inWidth, uint32_t inHeight, int phase, WorkerPool* pool)
 	{
 		if(GenericNtscFilter::NtscFilterOptionsChanged(_ntscSetup, _emu->GetSettings()->GetVideoConfig())) {
 			GenericNtscFilter::InitNtscFilter(_ntscSetup, _emu->GetSettings()->GetVideoConfig());
@@ -97,11 +98,19 @@ public:
 		uint32_t outWidth = SNES_NTSC_OUT_WIDTH(inWidth);
 		UpdateBufferSize(inWidth, inHeight);
 
-		//Convert RGB888 to RGB555
-		for(uint32_t i = 0; i < inWidth * inHeight; i++) {
-			_inputBuffer[i] = ColorUtilities::Rgb888To555(inOut[i]);
-		}
+		//The output is written over the input, so the whole frame must be converted before the blit can start
+		uint16_t* inputBuffer = _inputBuffer;
+		pool->RunRowBands(inHeight, [=](uint32_t firstRow, uint32_t endRow) {
+			//Convert RGB888 to RGB555
+			for(uint32_t i = firstRow * inWidth; i < endRow * inWidth; i++) {
+				inputBuffer[i] = ColorUtilities::Rgb888To555(inOut[i]);
+			}
+		});
 
-		snes_ntsc_blit(&_ntscData, _inputBuffer, inWidth, phase, inWidth, inHeight, inOut, outWidth * sizeof(uint32_t));
+		//The burst phase moves forward by 1 on each row, so each band starts at the phase the serial blit would be at
+		snes_ntsc_t* ntscData = &_ntscData;
+		pool->RunRowBands(inHeight, [=](uint32_t firstRow, uint32_t endRow) {
+			snes_ntsc_blit(ntscData, inputBuffer + firstRow * inWidth, inWidth, (phase + firstRow) % snes_ntsc_burst_count, inWidth, endRow - firstRow, inOut + firstRow * outWidth, outWidth * sizeof(uint32_t));
+		});
 	}
 };
@@ -2,12 +2,14 @@
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Video/ScaleFilter.h"
+#include "Shared/Video/VideoKernels.h"
 #include "Utilities/xBRZ/xbrz.h"
 #include "Utilities/HQX/hqx.h"
 #include "Utilities/Scale2x/scalebit.h"
 #include "Utilities/KreedSaiEagle/SaiEagle.h"
+#include "Utilities/WorkerPool.h"
 
-bool ScaleFilter::_hqxInitDone = false;
+std::once_flag ScaleFilter::_hqxInitFlag;
 
 ScaleFilter::ScaleFilter(Emulator* emu, ScaleFilterType scaleFilterType, uint32_t scale)
 {
@@ -15,9 +17,9 @@ ScaleFilter::ScaleFilter(Emulator* emu, ScaleFilterType scaleFilterType, uint32_
 	_scaleFilterType = scaleFilterType;
 	_filterScale = scale;
 
-	if(!_hqxInitDone && _scaleFilterType == ScaleFilterType::HQX) {
-		hqxInit();
-		_hqxInitDone = true;
+	if(_scaleFilterType == ScaleFilterType::HQX) {
+		//The lookup tables are shared by all emulator instances
+		std::call_once(_hqxInitFlag, []() { hqxInit(); });
 	}
 }
 
@@ -31,15 +33,6 @@ uint32_t ScaleFilter::GetScale()
 	return _filterScale;
 }
 
-uint32_t ScaleFilter::ApplyBrightness(uint32_t argb, uint8_t brightness)
-{
-	uint8_t r = ((argb & 0xFF0000) >> 16) * brightness / 255;
-	uint8_t g = ((argb & 0xFF00) >> 8) * brightness / 255;
-	uint8_t b = (argb & 0xFF) * brightness / 255;
-
-	return 0xFF000000 | (r << 16) | (g << 8) | b;
-}
-
 void ScaleFilter::ApplyLcdGridFilter(uint32_t* inputArgbBuffer)
 {
 	VideoConfig& cfg = _emu->GetSettings()->GetVideoConfig();
@@ -48,33 +41,28 @@ void ScaleFilter::ApplyLcdGridFilter(uint32_t* inputArgbBuffer)
 	uint8_t bottomLeft = (uint8_t)(cfg.LcdGridBottomLeftBrightness * 255);
 	uint8_t bottomRight = (uint8_t)(cfg.LcdGridBottomRightBrightness * 255);
 
+	uint32_t outWidth = _width * _filterScale;
 	for(uint32_t y = 0; y < _height; y++) {
-		for(uint32_t x = 0; x < _width; x++) {
-			uint32_t srcColor = inputArgbBuffer[y * _width + x];
-			
-			uint32_t pos = y * _width * _filterScale * 2 + x * _filterScale;
-			_outputBuffer[pos] = ApplyBrightness(srcColor, topLeft);
-			_outputBuffer[pos + 1] = ApplyBrightness(srcColor, topRight);
-			_outputBuffer[pos + _width * _filterScale] = ApplyBrightness(srcColor, bottomLeft);
-			_outputBuffer[pos + _width * _filterScale + 1] = ApplyBrightness(srcColor, bottomRight);
-		}
+		uint32_t* src = inputArgbBuffer + y * _width;
+		uint32_t* out = _outputBuffer + y * outWidth * 2;
+		VideoKernels::ApplyBrightnessDoubleWidth(src, out, _width, topLeft, topRight);
+		VideoKernels::ApplyBrightnessDoubleWidth(src, out + outWidth, _width, bottomLeft, bottomRight);
 	}
 }
 
 void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer)
 {
 	uint32_t* outputBuffer = _outputBuffer;
+	uint32_t outWidth = _width * _filterScale;
 
 	for(uint32_t y = 0; y < _height; y++) {
-		for(uint32_t x = 0; x < _width; x++) {
-			for(uint32_t i = 0; i < _filterScale; i++) {
-				*(outputBuffer++) = *inputArgbBuffer;
-			}
-			inputArgbBuffer++;
-		}
+		VideoKernels::RepeatPixels(inputArgbBuffer, outputBuffer, _width, _filterScale);
+		inputArgbBuffer += _width;
+		outputBuffer += outWidth;
+
 		for(uint32_t i = 1; i < _filterScale; i++) {
-			memcpy(outputBuffer, outputBuffer - _width*_filterScale, _width*_filterScale *4);
-			outputBuffer += _width*_filterScale;
+			memcpy(outputBuffer, outputBuffer - outWidth, outWidth * 4);
+			outputBuffer += outWidth;
 		}
 	}
 }
@@ -89,22 +77,57 @@ void ScaleFilter::UpdateOutputBuffer(uint32_t width, uint32_t height)
 	}
 }
 
+template<typename T>
+void ScaleFilter::ProcessSlices(uint32_t height, T processSlice)
+{
+	//Each algorithm reads the rows around its slice as needed, so the result is identical to processing the whole image at once
+	_workerPool->RunRowBands(height, processSlice);
+}
+
 uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height)
 {
 	UpdateOutputBuffer(width, height);
+	WorkerPool::Update(_workerPool, _emu->GetSettings()->GetVideoConfig().FilterThreadCount);
+
+	uint32_t* out = _outputBuffer;
+	uint32_t scale = _filterScale;
 
 	if(_scaleFilterType == ScaleFilterType::xBRZ) {
-		xbrz::scale(_filterScale, inputArgbBuffer, _outputBuffer, width, height, xbrz::ColorFormat::ARGB);
+		ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+			xbrz::scale(scale, inputArgbBuffer, out, width, height, xbrz::ColorFormat::ARGB, xbrz::ScalerCfg(), yFirst, yLast);
+		});
 	} else if(_scaleFilterType == ScaleFilterType::HQX) {
-		hqx(_filterScale, inputArgbBuffer, _outputBuffer, width, height);
+		ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+			hqx(scale, inputArgbBuffer, out, width, height, yFirst, yLast);
+		});
 	} else if(_scaleFilterType == ScaleFilterType::Scale2x) {
-		scale(_filterScale, _outputBuffer, width*sizeof(uint32_t)*_filterScale, inputArgbBuffer, width*sizeof(uint32_t), 4, width, height);
+		if(scale == 4) {
+			//Scale4x is Scale2x applied twice
+			_scale2xBuffer.resize(width * height * 4);
+			uint32_t* tmp = _scale2xBuffer.data();
+			ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+				scale_slice(2, tmp, width * sizeof(uint32_t) * 2, inputArgbBuffer, width * sizeof(uint32_t), 4, width, height, yFirst, yLast);
+			});
+			ProcessSlices(height * 2, [=](uint32_t yFirst, uint32_t yLast) {
+				scale_slice(2, out, width * sizeof(uint32_t) * 4, tmp, width * sizeof(uint32_t) * 2, 4, width * 2, height * 2, yFirst, yLast);
+			});
+		} else {
+			ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+				scale_slice(scale, out, width * sizeof(uint32_t) * scale, inputArgbBuffer, width * sizeof(uint32_t), 4, width, height, yFirst, yLast);
+			});
+		}
 	} else if(_scaleFilterType == ScaleFilterType::_2xSai) {
-		twoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
+		ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+			twoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, out, width * scale, yFirst, yLast);
+		});
 	} else if(_scaleFilterType == ScaleFilterType::Super2xSai) {
-		supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
+		ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+			supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, out, width * scale, yFirst, yLast);
+		});
 	} else if(_scaleFilterType == ScaleFilterType::SuperEagle) {
-		supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
+		ProcessSlices(height, [=](uint32_t yFirst, uint32_t yLast) {
+			supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, out, width * scale, yFirst, yLast);
+		});
 	} else if(_scaleFilterType == ScaleFilterType::Prescale) {
 		ApplyPrescaleFilter(inputArgbBuffer);
 	} else if(_scaleFilterType == ScaleFilterType::LcdGrid) {
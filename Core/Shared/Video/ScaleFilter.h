@@ -1,14 +1,17 @@
 #pragma once
 
 #include "pch.h"
+#include <mutex>
 #include "Shared/SettingTypes.h"
 
+class WorkerPool;
+
 class Emulator;
 
 class ScaleFilter
 {
 private:
-	static bool _hqxInitDone;
+	static std::once_flag _hqxInitFlag;
 	
 	Emulator* _emu = nullptr;
 
@@ -18,12 +21,16 @@ private:
 	uint32_t _width = 0;
 	uint32_t _height = 0;
 
-	uint32_t ApplyBrightness(uint32_t argb, uint8_t brightness);
+	unique_ptr<WorkerPool> _workerPool;
+	vector<uint32_t> _scale2xBuffer;
+
 	void ApplyLcdGridFilter(uint32_t* inputArgbBuffer);
 
 	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer);
 	void UpdateOutputBuffer(uint32_t width, uint32_t height);
 
+	template<typename T> void ProcessSlices(uint32_t height, T processSlice);
+
 public:
 	ScaleFilter(Emulator* emu, ScaleFilterType scaleFilterType, uint32_t scale);
 	~ScaleFilter();
@@ -182,6 +182,12 @@ void VideoDecoder::UpdateFrame(RenderedFrame frame, bool sync, bool forRewind)
 		return;
 	}
 
+	if(_emu->IsHeadless()) {
+		//No decode thread is running, nothing would ever consume the frame
+		_frameCount++;
+		return;
+	}
+
 	if(_frameChanged) {
 		//Last frame isn't done decoding yet - sometimes Signal() introduces a 25-30ms delay
 		while(_frameChanged) {
@@ -0,0 +1,281 @@
+#include "pch.h"
+#include "Shared/Video/VideoKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+	#define VIDEO_KERNELS_X86
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define AVX2_FUNC
+	#else
+		//Only the AVX2 functions are compiled with AVX2 enabled, the rest of the code can still run on any x86 CPU
+		#define AVX2_FUNC __attribute__((target("avx2")))
+	#endif
+#endif
+
+static bool DetectAvx2()
+{
+#if defined(VIDEO_KERNELS_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if(info[0] < 7) {
+		return false;
+	}
+
+	//Check for AVX support, and that the OS saves the YMM registers
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if(!osxsave || !avx || (_xgetbv(0) & 0x06) != 0x06) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(VIDEO_KERNELS_X86)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+bool VideoKernels::IsAvx2Enabled()
+{
+	static bool enabled = DetectAvx2();
+	return enabled;
+}
+
+#ifdef VIDEO_KERNELS_X86
+AVX2_FUNC static __m256i Avx2BlendPixels(__m256i a, __m256i b)
+{
+	__m256i diff = _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_set1_epi32((int)0xfffefefe));
+	return _mm256_add_epi32(_mm256_srli_epi32(diff, 1), _mm256_and_si256(a, b));
+}
+
+AVX2_FUNC static __m256i Avx2GetPixels(const uint32_t* palette, const uint16_t* src, __m256i mask)
+{
+	__m256i indexes = _mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)src)), mask);
+	return _mm256_i32gather_epi32((const int*)palette, indexes, 4);
+}
+
+AVX2_FUNC static void Avx2StoreDoubleWidth(uint32_t* dst, __m256i left, __m256i right)
+{
+	//unpack works within each 128-bit lane, the permutes put the pixels back in order
+	__m256i lo = _mm256_unpacklo_epi32(left, right);
+	__m256i hi = _mm256_unpackhi_epi32(left, right);
+	_mm256_storeu_si256((__m256i*)dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+	_mm256_storeu_si256((__m256i*)(dst + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+AVX2_FUNC static __m256i Avx2ApplyBrightness(__m256i argb, __m256i brightness)
+{
+	__m256i zero = _mm256_setzero_si256();
+	__m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(argb, zero), brightness);
+	__m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(argb, zero), brightness);
+
+	//x * 0x8081 >> 23 == x / 255 for all 16-bit values
+	__m256i divider = _mm256_set1_epi16((short)0x8081);
+	lo = _mm256_srli_epi16(_mm256_mulhi_epu16(lo, divider), 7);
+	hi = _mm256_srli_epi16(_mm256_mulhi_epu16(hi, divider), 7);
+
+	return _mm256_or_si256(_mm256_packus_epi16(lo, hi), _mm256_set1_epi32((int)0xFF000000));
+}
+
+AVX2_FUNC static uint32_t Avx2ConvertPixels(const uint32_t* palette, const uint16_t* src, uint32_t* dst, uint32_t count, uint16_t mask)
+{
+	__m256i maskVec = _mm256_set1_epi32(mask);
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		_mm256_storeu_si256((__m256i*)(dst + i), Avx2GetPixels(palette, src + i, maskVec));
+	}
+	return i;
+}
+
+AVX2_FUNC static uint32_t Avx2ConvertPixelsDoubleWidth(const uint32_t* palette, const uint16_t* src, uint32_t* dst, uint32_t count)
+{
+	__m256i maskVec = _mm256_set1_epi32(0xFFFF);
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		__m256i pixels = Avx2GetPixels(palette, src + i, maskVec);
+		Avx2StoreDoubleWidth(dst + i * 2, pixels, pixels);
+	}
+	return i;
+}
+
+AVX2_FUNC static uint32_t Avx2ConvertAndBlendPixels(const uint32_t* palette, const uint16_t* prevSrc, const uint16_t* src, uint32_t* dst, uint32_t count, uint16_t mask)
+{
+	__m256i maskVec = _mm256_set1_epi32(mask);
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		__m256i prev = Avx2GetPixels(palette, prevSrc + i, maskVec);
+		__m256i cur = Avx2GetPixels(palette, src + i, maskVec);
+		_mm256_storeu_si256((__m256i*)(dst + i), Avx2BlendPixels(prev, cur));
+	}
+	return i;
+}
+
+AVX2_FUNC static uint32_t Avx2BlendWithNextPixel(uint32_t* buffer, uint32_t count)
+{
+	//Works in place: buffer[i+8] is loaded before it gets overwritten by the next iteration
+	uint32_t i = 0;
+	for(; i + 8 < count; i += 8) {
+		__m256i a = _mm256_loadu_si256((__m256i*)(buffer + i));
+		__m256i b = _mm256_loadu_si256((__m256i*)(buffer + i + 1));
+		_mm256_storeu_si256((__m256i*)(buffer + i), Avx2BlendPixels(a, b));
+	}
+	return i;
+}
+
+AVX2_FUNC static uint32_t Avx2RepeatPixels(const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t scale)
+{
+	if(scale == 2) {
+		uint32_t i = 0;
+		for(; i + 8 <= count; i += 8) {
+			__m256i pixels = _mm256_loadu_si256((__m256i*)(src + i));
+			Avx2StoreDoubleWidth(dst + i * 2, pixels, pixels);
+		}
+		return i;
+	}
+
+	//Each pixel is written with full 8-pixel stores - when scale isn't a multiple of 8, the extra
+	//pixels written past the pixel's range are overwritten by the next pixel
+	uint32_t outSize = count * scale;
+	uint32_t i = 0;
+	for(; i < count && i * scale + std::max<uint32_t>(scale, 8) <= outSize; i++) {
+		__m256i pixel = _mm256_set1_epi32((int)src[i]);
+		uint32_t* out = dst + i * scale;
+		for(uint32_t j = 0; j + 8 < scale; j += 8) {
+			_mm256_storeu_si256((__m256i*)(out + j), pixel);
+		}
+		_mm256_storeu_si256((__m256i*)(out + (scale > 8 ? scale - 8 : 0)), pixel);
+	}
+	return i;
+}
+
+AVX2_FUNC static uint32_t Avx2ApplyBrightness(const uint32_t* src, uint32_t* dst, uint32_t count, uint8_t brightness)
+{
+	__m256i brightnessVec = _mm256_set1_epi16(brightness);
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		__m256i pixels = _mm256_loadu_si256((__m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), Avx2ApplyBrightness(pixels, brightnessVec));
+	}
+	return i;
+}
+
+AVX2_FUNC static uint32_t Avx2ApplyBrightnessDoubleWidth(const uint32_t* src, uint32_t* dst, uint32_t count, uint8_t leftBrightness, uint8_t rightBrightness)
+{
+	__m256i left = _mm256_set1_epi16(leftBrightness);
+	__m256i right = _mm256_set1_epi16(rightBrightness);
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		__m256i pixels = _mm256_loadu_si256((__m256i*)(src + i));
+		Avx2StoreDoubleWidth(dst + i * 2, Avx2ApplyBrightness(pixels, left), Avx2ApplyBrightness(pixels, right));
+	}
+	return i;
+}
+#endif
+
+//Each function processes as many pixels as possible with AVX2 (when available), and the remaining ones with the scalar loop
+void VideoKernels::ConvertPixels(const uint32_t* palette, const uint16_t* src, uint32_t* dst, uint32_t count, uint16_t mask)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2ConvertPixels(palette, src, dst, count, mask);
+	}
+#endif
+
+	for(; i < count; i++) {
+		dst[i] = palette[src[i] & mask];
+	}
+}
+
+void VideoKernels::ConvertPixelsDoubleWidth(const uint32_t* palette, const uint16_t* src, uint32_t* dst, uint32_t count)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2ConvertPixelsDoubleWidth(palette, src, dst, count);
+	}
+#endif
+
+	for(; i < count; i++) {
+		dst[i * 2] = dst[i * 2 + 1] = palette[src[i]];
+	}
+}
+
+void VideoKernels::ConvertAndBlendPixels(const uint32_t* palette, const uint16_t* prevSrc, const uint16_t* src, uint32_t* dst, uint32_t count, uint16_t mask)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2ConvertAndBlendPixels(palette, prevSrc, src, dst, count, mask);
+	}
+#endif
+
+	for(; i < count; i++) {
+		dst[i] = BlendPixels(palette[prevSrc[i] & mask], palette[src[i] & mask]);
+	}
+}
+
+void VideoKernels::BlendWithNextPixel(uint32_t* buffer, uint32_t count)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2BlendWithNextPixel(buffer, count);
+	}
+#endif
+
+	for(; i + 1 < count; i++) {
+		buffer[i] = BlendPixels(buffer[i], buffer[i + 1]);
+	}
+}
+
+void VideoKernels::RepeatPixels(const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t scale)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2RepeatPixels(src, dst, count, scale);
+	}
+#endif
+
+	for(; i < count; i++) {
+		for(uint32_t j = 0; j < scale; j++) {
+			dst[i * scale + j] = src[i];
+		}
+	}
+}
+
+void VideoKernels::ApplyBrightness(const uint32_t* src, uint32_t* dst, uint32_t count, uint8_t brightness)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2ApplyBrightness(src, dst, count, brightness);
+	}
+#endif
+
+	for(; i < count; i++) {
+		dst[i] = ApplyBrightness(src[i], brightness);
+	}
+}
+
+void VideoKernels::ApplyBrightnessDoubleWidth(const uint32_t* src, uint32_t* dst, uint32_t count, uint8_t leftBrightness, uint8_t rightBrightness)
+{
+	uint32_t i = 0;
+#ifdef VIDEO_KERNELS_X86
+	if(IsAvx2Enabled()) {
+		i = Avx2ApplyBrightnessDoubleWidth(src, dst, count, leftBrightness, rightBrightness);
+	}
+#endif
+
+	for(; i < count; i++) {
+		uint32_t pixel = src[i];
+		dst[i * 2] = ApplyBrightness(pixel, leftBrightness);
+		dst[i * 2 + 1] = ApplyBrightness(pixel, rightBrightness);
+	}
+}
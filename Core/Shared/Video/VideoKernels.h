@@ -0,0 +1,45 @@
+#pragma once
+#include "pch.h"
+
+//Pixel conversion loops shared by the video filters.
+//An AVX2 version of each function is used when the CPU supports it, otherwise the scalar version is used.
+class VideoKernels
+{
+public:
+	static bool IsAvx2Enabled();
+
+	//dst[i] = palette[src[i] & mask]
+	static void ConvertPixels(const uint32_t* palette, const uint16_t* src, uint32_t* dst, uint32_t count, uint16_t mask = 0xFFFF);
+
+	//dst[i*2] = dst[i*2+1] = palette[src[i]]
+	static void ConvertPixelsDoubleWidth(const uint32_t* palette, const uint16_t* src, uint32_t* dst, uint32_t count);
+
+	//dst[i] = BlendPixels(palette[prevSrc[i] & mask], palette[src[i] & mask])
+	static void ConvertAndBlendPixels(const uint32_t* palette, const uint16_t* prevSrc, const uint16_t* src, uint32_t* dst, uint32_t count, uint16_t mask = 0xFFFF);
+
+	//buffer[i] = BlendPixels(buffer[i], buffer[i+1]), the last pixel is left as is
+	static void BlendWithNextPixel(uint32_t* buffer, uint32_t count);
+
+	//Writes each pixel "scale" times in a row
+	static void RepeatPixels(const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t scale);
+
+	//Multiplies each color channel by brightness/255, alpha is set to 0xFF
+	static void ApplyBrightness(const uint32_t* src, uint32_t* dst, uint32_t count, uint8_t brightness);
+
+	//dst[i*2] = src[i] with leftBrightness, dst[i*2+1] = src[i] with rightBrightness
+	static void ApplyBrightnessDoubleWidth(const uint32_t* src, uint32_t* dst, uint32_t count, uint8_t leftBrightness, uint8_t rightBrightness);
+
+	static uint32_t BlendPixels(uint32_t a, uint32_t b)
+	{
+		return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
+	}
+
+	static uint32_t ApplyBrightness(uint32_t argb, uint8_t brightness)
+	{
+		uint8_t r = ((argb & 0xFF0000) >> 16) * brightness / 255;
+		uint8_t g = ((argb & 0xFF00) >> 8) * brightness / 255;
+		uint8_t b = (argb & 0xFF) * brightness / 255;
+
+		return 0xFF000000 | (r << 16) | (g << 8) | b;
+	}
+};
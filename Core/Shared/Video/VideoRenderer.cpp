@@ -203,6 +203,12 @@ void VideoRenderer::UnregisterRenderingDevice(IRenderingDevice *renderer)
 
 void VideoRenderer::ProcessAviRecording(RenderedFrame& frame)
 {
+	if(!_recorder) {
+		return;
+	}
+
+	//Prevents StopRecording from stopping the recorder while a frame is being added (or from having it restarted afterwards)
+	auto lock = _recorderLock.AcquireSafe();
 	shared_ptr<IVideoRecorder> recorder = _recorder.lock();
 	if(recorder) {
 		if(!recorder->IsRecording()) {
@@ -253,9 +259,9 @@ void VideoRenderer::StartRecording(string filename, RecordAviOptions options)
 
 	shared_ptr<IVideoRecorder> recorder;
 	if(options.Codec == VideoCodec::GIF) {
-		recorder.reset(new GifRecorder());
+		recorder.reset(new GifRecorder(options.FramePolicy));
 	} else {
-		recorder.reset(new AviRecorder(options.Codec, options.CompressionLevel));
+		recorder.reset(new AviRecorder(options.Codec, options.CompressionLevel, options.FramePolicy));
 	}
 
 	if(recorder->Init(filename)) {
@@ -282,8 +288,15 @@ void VideoRenderer::AddRecordingSound(int16_t* soundBuffer, uint32_t sampleCount
 
 void VideoRenderer::StopRecording()
 {
+	auto lock = _recorderLock.AcquireSafe();
 	shared_ptr<IVideoRecorder> recorder = _recorder.lock();
 	if(recorder) {
+		//Wait for the queued frames to be encoded first, so the stats include them
+		recorder->StopRecording();
+		RecordingStats stats = recorder->GetStats();
+		if(stats.DroppedFrames || stats.LateFrames) {
+			MessageManager::Log("[Video Recorder] " + std::to_string(stats.FrameCount) + " frames, " + std::to_string(stats.DroppedFrames) + " dropped, " + std::to_string(stats.LateFrames) + " late (emulation waited for the encoder)");
+		}
 		MessageManager::DisplayMessage("VideoRecorder", "VideoRecorderStopped", recorder->GetOutputFile());
 	}
 	_aviRecorderSurface.UpdateSize(0, 0);
@@ -16,6 +16,7 @@ class InputHud;
 
 class IVideoRecorder;
 enum class VideoCodec;
+enum class RecordFramePolicy;
 
 struct RecordAviOptions
 {
@@ -23,6 +24,7 @@ struct RecordAviOptions
 	uint32_t CompressionLevel;
 	bool RecordSystemHud;
 	bool RecordInputHud;
+	RecordFramePolicy FramePolicy;
 };
 
 class VideoRenderer
@@ -58,6 +60,7 @@ private:
 	SimpleLock _frameLock;
 
 	safe_ptr<IVideoRecorder> _recorder;
+	SimpleLock _recorderLock;
 
 	void RenderThread();
 	bool DrawScriptHud(RenderedFrame& frame);
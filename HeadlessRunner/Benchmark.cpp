@@ -0,0 +1,244 @@
+#include "pch.h"
+#include <iostream>
+#include <algorithm>
+#include "Core/Shared/Emulator.h"
+#include "Core/Shared/BatchRunner.h"
+#include "Core/Shared/MessageManager.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/magic_enum.hpp"
+
+struct BenchMode
+{
+	string Name;
+	bool Headless;
+	BatchRunOptions Options;
+};
+
+struct BenchResult
+{
+	string RomFile;
+	string Mode;
+	BatchRunResult LastRun;
+	vector<double> Fps;
+	vector<double> CyclesPerSecond;
+};
+
+static void PrintUsage()
+{
+	std::cerr << "Usage: bench <rom> [<rom> ...] [options]" << std::endl;
+	std::cerr << "  --frames <count>           Number of frames to run for each measurement (default: 1000)" << std::endl;
+	std::cerr << "  --repeat <count>           Number of measurements per rom and mode, the median is reported (default: 3)" << std::endl;
+	std::cerr << "  --modes <list>             Comma-separated list of modes to run (default: baseline,debugger,runahead,rewind,filter)" << std::endl;
+	std::cerr << "  --filter <name>            Video filter used by the filter mode (default: NtscBlargg)" << std::endl;
+	std::cerr << "  --timeout <seconds>        Abort a measurement after the given amount of time" << std::endl;
+	std::cerr << "  --home <folder>            Home folder used for firmware/saves (default: ./MesenHeadless)" << std::endl;
+	std::cerr << "  --output <file>            Write the results to a file instead of stdout" << std::endl;
+	std::cerr << "  --log                      Print the emulator's log to stderr when done" << std::endl;
+}
+
+static vector<BenchMode> GetModes(BatchRunOptions& baseOptions, VideoFilterType filter)
+{
+	vector<BenchMode> modes;
+
+	BenchMode mode = { "baseline", true, baseOptions };
+	modes.push_back(mode);
+
+	mode = { "debugger", true, baseOptions };
+	mode.Options.EnableDebugger = true;
+	modes.push_back(mode);
+
+	mode = { "runahead", true, baseOptions };
+	mode.Options.RunAheadFrames = 1;
+	modes.push_back(mode);
+
+	mode = { "rewind", true, baseOptions };
+	mode.Options.EnableRewind = true;
+	modes.push_back(mode);
+
+	//The video filter only runs on the decode thread, which headless instances don't have
+	mode = { "filter", false, baseOptions };
+	mode.Options.VideoFilter = filter;
+	modes.push_back(mode);
+
+	return modes;
+}
+
+static double GetMedian(vector<double> values)
+{
+	if(values.empty()) {
+		return 0;
+	}
+
+	std::sort(values.begin(), values.end());
+	size_t middle = values.size() / 2;
+	return (values.size() & 0x01) ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+static BenchResult RunMode(string romFile, BenchMode& mode, uint32_t repeatCount)
+{
+	BenchResult result = {};
+	result.RomFile = romFile;
+	result.Mode = mode.Name;
+
+	for(uint32_t i = 0; i < repeatCount; i++) {
+		//Use a new instance for every measurement to avoid any state carrying over between runs
+		unique_ptr<Emulator> emu(new Emulator());
+		emu->Initialize(false, mode.Headless);
+
+		BatchRunOptions options = mode.Options;
+		options.RomFile = romFile;
+
+		shared_ptr<BatchRunner> runner(new BatchRunner(emu.get()));
+		result.LastRun = runner->Run(options);
+
+		emu->Release();
+
+		if(result.LastRun.StopReason != BatchStopReason::FrameLimit) {
+			break;
+		}
+
+		result.Fps.push_back(BatchRunner::GetFps(result.LastRun));
+		result.CyclesPerSecond.push_back(BatchRunner::GetCyclesPerSecond(result.LastRun));
+	}
+
+	return result;
+}
+
+static void WriteJson(ostream& out, BenchResult& result)
+{
+	BatchRunResult& run = result.LastRun;
+
+	out << "    {\n";
+	out << "      \"rom\": \"" << BatchRunner::EscapeJson(result.RomFile) << "\",\n";
+	out << "      \"mode\": \"" << result.Mode << "\",\n";
+	out << "      \"console\": \"" << magic_enum::enum_name(run.Console) << "\",\n";
+
+	out << "      \"cpus\": [";
+	for(size_t i = 0; i < run.CpuTypes.size(); i++) {
+		out << (i > 0 ? ", " : "") << "\"" << magic_enum::enum_name(run.CpuTypes[i]) << "\"";
+	}
+	out << "],\n";
+
+	if(result.Fps.empty()) {
+		out << "      \"error\": \"" << magic_enum::enum_name(run.StopReason) << "\"\n";
+	} else {
+		auto minMax = std::minmax_element(result.Fps.begin(), result.Fps.end());
+		out << "      \"frames\": " << run.FrameCount << ",\n";
+		out << "      \"masterClock\": " << run.MasterClock << ",\n";
+		out << "      \"fps\": " << std::fixed << std::setprecision(3) << GetMedian(result.Fps) << ",\n";
+		out << "      \"fpsMin\": " << std::fixed << std::setprecision(3) << *minMax.first << ",\n";
+		out << "      \"fpsMax\": " << std::fixed << std::setprecision(3) << *minMax.second << ",\n";
+		out << "      \"cyclesPerSecond\": " << std::fixed << std::setprecision(0) << GetMedian(result.CyclesPerSecond) << "\n";
+	}
+	out << "    }";
+}
+
+int main(int argc, char* argv[])
+{
+	vector<string> romFiles;
+	vector<string> modeNames;
+	uint32_t repeatCount = 3;
+	VideoFilterType filter = VideoFilterType::NtscBlargg;
+	BatchRunOptions baseOptions;
+	baseOptions.FrameCount = 1000;
+	string homeFolder = "MesenHeadless";
+	string outputFile;
+	bool printLog = false;
+
+	for(int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		try {
+			if(arg == "--frames" && hasValue) {
+				baseOptions.FrameCount = std::max(1u, (uint32_t)std::stoul(argv[++i]));
+			} else if(arg == "--repeat" && hasValue) {
+				repeatCount = std::max(1u, (uint32_t)std::stoul(argv[++i]));
+			} else if(arg == "--timeout" && hasValue) {
+				baseOptions.Timeout = (uint32_t)(std::stod(argv[++i]) * 1000);
+			} else if(arg == "--modes" && hasValue) {
+				string list = argv[++i];
+				size_t start = 0;
+				size_t pos;
+				while((pos = list.find(',', start)) != string::npos) {
+					modeNames.push_back(list.substr(start, pos - start));
+					start = pos + 1;
+				}
+				modeNames.push_back(list.substr(start));
+			} else if(arg == "--filter" && hasValue) {
+				auto filterType = magic_enum::enum_cast<VideoFilterType>(argv[++i]);
+				if(!filterType.has_value()) {
+					std::cerr << "Invalid video filter: " << argv[i] << std::endl;
+					return -1;
+				}
+				filter = filterType.value();
+			} else if(arg == "--home" && hasValue) {
+				homeFolder = argv[++i];
+			} else if(arg == "--output" && hasValue) {
+				outputFile = argv[++i];
+			} else if(arg == "--log") {
+				printLog = true;
+			} else if(arg.size() > 0 && arg[0] != '-') {
+				romFiles.push_back(arg);
+			} else {
+				PrintUsage();
+				return -1;
+			}
+		} catch(std::exception&) {
+			std::cerr << "Invalid value for " << arg << std::endl;
+			return -1;
+		}
+	}
+
+	if(romFiles.empty()) {
+		PrintUsage();
+		return -1;
+	}
+
+	vector<BenchMode> modes;
+	for(BenchMode& mode : GetModes(baseOptions, filter)) {
+		if(modeNames.empty() || std::find(modeNames.begin(), modeNames.end(), mode.Name) != modeNames.end()) {
+			modes.push_back(mode);
+		}
+	}
+
+	if(modes.empty()) {
+		std::cerr << "No valid modes selected" << std::endl;
+		return -1;
+	}
+
+	FolderUtilities::SetHomeFolder(homeFolder);
+
+	ofstream outFile;
+	if(!outputFile.empty()) {
+		outFile.open(outputFile, ios::out | ios::binary);
+	}
+	ostream& out = outputFile.empty() ? std::cout : outFile;
+
+	out << "{\n";
+	out << "  \"frames\": " << baseOptions.FrameCount << ",\n";
+	out << "  \"repeat\": " << repeatCount << ",\n";
+	out << "  \"results\": [\n";
+
+	//Measurements run one at a time, running them in parallel would make the results depend on the number of cores/load
+	int failedCount = 0;
+	bool first = true;
+	for(string& romFile : romFiles) {
+		for(BenchMode& mode : modes) {
+			BenchResult result = RunMode(romFile, mode, repeatCount);
+			out << (first ? "" : ",\n");
+			WriteJson(out, result);
+			out.flush();
+			failedCount += result.Fps.empty() ? 1 : 0;
+			first = false;
+		}
+	}
+
+	out << "\n  ]\n}\n";
+
+	if(printLog) {
+		std::cerr << MessageManager::GetLog();
+	}
+
+	return failedCount;
+}
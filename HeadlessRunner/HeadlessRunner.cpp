@@ -0,0 +1,464 @@
+#include "pch.h"
+#include <iostream>
+#include "Core/Shared/Emulator.h"
+#include "Core/Shared/BatchRunner.h"
+#include "Core/Shared/TestFarm.h"
+#include "Core/Shared/MessageManager.h"
+#include "Core/Shared/EmuSettings.h"
+#include "Core/Shared/NotificationManager.h"
+#include "Core/Shared/Interfaces/INotificationListener.h"
+#include "Core/Shared/Interfaces/IInputProvider.h"
+#include "Core/Shared/BaseControlDevice.h"
+#include "Core/Netplay/GameServer.h"
+#include "Core/Netplay/GameClient.h"
+#include "Core/Netplay/ClientConnectionData.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/Timer.h"
+#include "Utilities/CRC32.h"
+#include "Utilities/magic_enum.hpp"
+
+static void PrintUsage()
+{
+	std::cerr << "Usage: headless <rom> [<rom> ...] [options]" << std::endl;
+	std::cerr << "  Multiple roms (or recorded tests, .mtp) run in parallel, one emulator instance per worker thread" << std::endl;
+	std::cerr << "  --frames <count>           Stop after running the given number of frames" << std::endl;
+	std::cerr << "  --movie <file>             Play back a movie (stops when the movie ends)" << std::endl;
+	std::cerr << "  --script <file>            Run a Lua script (emu.stop(code) stops the run and sets the exit code)" << std::endl;
+	std::cerr << "  --patch <file>             Apply a patch file (ips/bps/ups) to the rom" << std::endl;
+	std::cerr << "  --dump <type>[:start[:len]] Dump a memory region when the run ends (e.g NesInternalRam:0:0x800)" << std::endl;
+	std::cerr << "  --hashes                   Include the CRC32 of every frame in the output" << std::endl;
+	std::cerr << "  --timeout <seconds>        Stop after the given amount of time" << std::endl;
+	std::cerr << "  --compare-clock            Run each rom with and without the SNES clock scheduler and compare every frame" << std::endl;
+	std::cerr << "  --compare-coproc-sync      Same as --compare-clock, with the SNES coprocessors' batched sync enabled in the scheduled run" << std::endl;
+	std::cerr << "  --netplay-loopback <port>  Run a netplay server and a client (two instances, over 127.0.0.1) and compare their frames" << std::endl;
+	std::cerr << "                             The server's controller follows an input pattern the client can't predict, so the client has to roll back" << std::endl;
+	std::cerr << "  --rollback <frames>        Max rollback frames used by the --netplay-loopback client (default: 8, 0 = delay-based)" << std::endl;
+	std::cerr << "  --threads <count>          Number of worker threads used when running multiple files (default: one per core)" << std::endl;
+	std::cerr << "  --home <folder>            Home folder used for firmware/saves (default: ./MesenHeadless)" << std::endl;
+	std::cerr << "  --output <file>            Write the results to a file instead of stdout" << std::endl;
+	std::cerr << "  --log                      Print the emulator's log to stderr when done" << std::endl;
+}
+
+static bool ParseMemoryRegion(string arg, BatchMemoryRegion& region)
+{
+	vector<string> parts;
+	size_t start = 0;
+	size_t pos;
+	while((pos = arg.find(':', start)) != string::npos) {
+		parts.push_back(arg.substr(start, pos - start));
+		start = pos + 1;
+	}
+	parts.push_back(arg.substr(start));
+
+	auto memType = magic_enum::enum_cast<MemoryType>(parts[0]);
+	if(!memType.has_value() || parts.size() > 3) {
+		return false;
+	}
+
+	try {
+		region.Type = memType.value();
+		region.Start = parts.size() > 1 ? (uint32_t)std::stoul(parts[1], nullptr, 0) : 0;
+		region.Length = parts.size() > 2 ? (uint32_t)std::stoul(parts[2], nullptr, 0) : 0;
+	} catch(std::exception&) {
+		return false;
+	}
+	return true;
+}
+
+static int RunFarm(vector<string>& files, BatchRunOptions& options, uint32_t threadCount, ostream& out)
+{
+	vector<string> testFiles;
+	vector<BatchRunOptions> jobs;
+	for(string& file : files) {
+		if(FolderUtilities::GetExtension(file) == ".mtp") {
+			testFiles.push_back(file);
+		} else {
+			BatchRunOptions job = options;
+			job.RomFile = file;
+			jobs.push_back(job);
+		}
+	}
+
+	int failedCount = 0;
+	bool first = true;
+	out << "[\n";
+
+	vector<TestFarmResult> testResults = TestFarm::RunRecordedTests(testFiles, threadCount);
+	for(TestFarmResult& result : testResults) {
+		out << (first ? "" : ",\n");
+		TestFarm::WriteJson(out, result);
+		failedCount += result.Result.State == RomTestState::Failed ? 1 : 0;
+		first = false;
+	}
+
+	vector<BatchRunResult> batchResults = TestFarm::RunBatch(jobs, threadCount);
+	for(size_t i = 0; i < batchResults.size(); i++) {
+		BatchRunResult& result = batchResults[i];
+		out << (first ? "" : ",\n");
+		BatchRunner::WriteJson(out, jobs[i], result);
+		bool failed = result.StopReason == BatchStopReason::LoadFailed || result.StopReason == BatchStopReason::Timeout || result.StopCode != 0;
+		failedCount += failed ? 1 : 0;
+		first = false;
+	}
+
+	out << "]\n";
+
+	//Exit code is the number of failed tests
+	return failedCount;
+}
+
+static int RunClockComparison(vector<string>& files, BatchRunOptions& options, uint32_t threadCount, bool batchCoprocSync, ostream& out)
+{
+	//Each rom runs twice: once with the step-by-step master clock and per-step coprocessor sync (reference),
+	//and once with the clock scheduler (and the batched coprocessor sync, when requested)
+	vector<BatchRunOptions> jobs;
+	for(string& file : files) {
+		BatchRunOptions job = options;
+		job.RomFile = file;
+		job.RecordFrameHashes = true;
+		job.DisableClockScheduler = true;
+		job.BatchCoprocessorSync = false;
+		jobs.push_back(job);
+		job.DisableClockScheduler = false;
+		job.BatchCoprocessorSync = batchCoprocSync;
+		jobs.push_back(job);
+	}
+
+	vector<BatchRunResult> results = TestFarm::RunBatch(jobs, threadCount);
+
+	int failedCount = 0;
+	out << "[\n";
+	for(size_t i = 0; i < files.size(); i++) {
+		BatchRunResult& reference = results[i * 2];
+		BatchRunResult& result = results[i * 2 + 1];
+
+		int32_t firstMismatch = -1;
+		size_t frameCount = std::max(reference.FrameHashes.size(), result.FrameHashes.size());
+		for(size_t frame = 0; frame < frameCount; frame++) {
+			if(frame >= reference.FrameHashes.size() || frame >= result.FrameHashes.size() || reference.FrameHashes[frame] != result.FrameHashes[frame]) {
+				firstMismatch = (int32_t)frame;
+				break;
+			}
+		}
+
+		bool match = reference.StopReason != BatchStopReason::LoadFailed && firstMismatch < 0 && reference.MasterClock == result.MasterClock;
+		failedCount += match ? 0 : 1;
+
+		out << (i > 0 ? ",\n" : "");
+		out << "{\n";
+		out << "  \"rom\": \"" << BatchRunner::EscapeJson(files[i]) << "\",\n";
+		out << "  \"match\": " << (match ? "true" : "false") << ",\n";
+		out << "  \"frames\": " << reference.FrameCount << ",\n";
+		out << "  \"firstMismatchFrame\": " << firstMismatch << ",\n";
+		out << "  \"steppedFps\": " << std::fixed << std::setprecision(3) << BatchRunner::GetFps(reference) << ",\n";
+		out << "  \"scheduledFps\": " << std::fixed << std::setprecision(3) << BatchRunner::GetFps(result) << "\n";
+		out << "}";
+	}
+	out << "\n]\n";
+
+	//Exit code is the number of roms with mismatching results
+	return failedCount;
+}
+
+//Records the hash of every frame, indexed by the console's frame counter (which is synced by the netplay state)
+class LoopbackFrameRecorder : public INotificationListener
+{
+private:
+	Emulator* _emu;
+	SimpleLock _lock;
+	unordered_map<uint32_t, uint32_t> _hashes;
+	atomic<uint32_t> _syncedFrameCount;
+	bool _clearOnStateLoad;
+
+public:
+	LoopbackFrameRecorder(Emulator* emu, bool clearOnStateLoad) : _emu(emu), _clearOnStateLoad(clearOnStateLoad)
+	{
+		_syncedFrameCount = 0;
+	}
+
+	uint32_t GetSyncedFrameCount() { return _syncedFrameCount; }
+
+	unordered_map<uint32_t, uint32_t> GetHashes()
+	{
+		auto lock = _lock.AcquireSafe();
+		return _hashes;
+	}
+
+	void ProcessNotification(ConsoleNotificationType type, void* parameter) override
+	{
+		if(type == ConsoleNotificationType::PpuFrameDone) {
+			//Frames emulated again by a rollback overwrite the mispredicted ones
+			PpuFrameInfo frame = _emu->GetPpuFrame();
+			auto lock = _lock.AcquireSafe();
+			_hashes[frame.FrameCount] = CRC32::GetCRC(frame.FrameBuffer, frame.FrameBufferSize);
+			_syncedFrameCount = (uint32_t)_hashes.size();
+		} else if(type == ConsoleNotificationType::StateLoaded && _clearOnStateLoad) {
+			//The client's frames before the server's state was loaded don't match anything
+			auto lock = _lock.AcquireSafe();
+			_hashes.clear();
+			_syncedFrameCount = 0;
+		}
+	}
+};
+
+//Presses buttons on the server's controller (a remote player for the client), changing them every 12 frames.
+//The client predicts that the buttons don't change, so its predictions are regularly wrong and have to be rolled back
+class LoopbackInputScript : public IInputProvider
+{
+private:
+	Emulator* _emu;
+	NetplayControllerInfo _port;
+	atomic<bool> _holdInput;
+	uint8_t _buttons = 0;
+
+public:
+	LoopbackInputScript(Emulator* emu, NetplayControllerInfo port) : _emu(emu), _port(port)
+	{
+		_holdInput = false;
+	}
+
+	//Keeps pressing the same buttons from now on, so the client's last predictions are correct
+	void HoldInput() { _holdInput = true; }
+
+	bool SetInput(BaseControlDevice* device) override
+	{
+		if(device->GetPort() != _port.Port) {
+			return false;
+		}
+
+		if(!_holdInput) {
+			_buttons = (uint8_t)(((_emu->GetFrameCount() / 12) * 2654435761u) >> 24);
+		}
+		for(uint8_t bit = 0; bit < 8; bit++) {
+			device->SetBitValue(bit, (_buttons >> bit) & 0x01);
+		}
+		return true;
+	}
+};
+
+static void InitLoopbackInstance(Emulator* emu)
+{
+	emu->Initialize(false, true);
+	EmuSettings* settings = emu->GetSettings();
+	settings->SetFlag(EmulationFlags::ConsoleMode);
+	settings->GetPreferences().DisableGameSelectionScreen = true;
+	settings->GetSnesConfig().DisableFrameSkipping = true;
+	settings->GetPcEngineConfig().DisableFrameSkipping = true;
+	settings->GetGbaConfig().DisableFrameSkipping = true;
+}
+
+static int RunNetplayLoopback(string& file, BatchRunOptions& options, uint16_t port, uint32_t rollbackFrames, ostream& out)
+{
+	//Both instances run in this process - the client loads the rom from its folder when the server sends the game
+	FolderUtilities::AddKnownGameFolder(FolderUtilities::GetFolderName(file));
+
+	unique_ptr<Emulator> host(new Emulator());
+	unique_ptr<Emulator> client(new Emulator());
+	InitLoopbackInstance(host.get());
+	InitLoopbackInstance(client.get());
+
+	//The client runs as fast as it can, so it is always ahead of the server's input (up to the rollback limit) and has to predict it
+	client->GetSettings()->GetEmulationConfig().EmulationSpeed = 0;
+
+	shared_ptr<LoopbackFrameRecorder> hostFrames(new LoopbackFrameRecorder(host.get(), false));
+	shared_ptr<LoopbackFrameRecorder> clientFrames(new LoopbackFrameRecorder(client.get(), true));
+	host->GetNotificationManager()->RegisterNotificationListener(hostFrames);
+	client->GetNotificationManager()->RegisterNotificationListener(clientFrames);
+
+	bool loaded = host->LoadRom((VirtualFile)file, (VirtualFile)options.PatchFile);
+	bool connected = false;
+	uint32_t rollbackCount = 0;
+	unique_ptr<LoopbackInputScript> inputScript;
+	if(loaded) {
+		host->GetGameServer()->StartServer(port, "");
+		inputScript.reset(new LoopbackInputScript(host.get(), host->GetGameServer()->GetHostControllerPort()));
+		host->RegisterInputProvider(inputScript.get());
+
+		ClientConnectionData connectionData("127.0.0.1", port, "", false, rollbackFrames);
+		client->GetGameClient()->Connect(connectionData);
+		connected = client->GetGameClient()->Connected();
+
+		//Once the requested frames have run, the input stops changing and the client runs more frames than it
+		//can roll back, so every frame it ran has been corrected with the server's input before the comparison
+		uint32_t endFrame = options.FrameCount + rollbackFrames + 60;
+		Timer timer;
+		while(connected && clientFrames->GetSyncedFrameCount() < endFrame) {
+			if(options.Timeout > 0 && timer.GetElapsedMS() > options.Timeout) {
+				break;
+			}
+			if(clientFrames->GetSyncedFrameCount() >= options.FrameCount) {
+				inputScript->HoldInput();
+			}
+			connected = client->GetGameClient()->Connected();
+			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(10));
+		}
+
+		rollbackCount = client->GetGameClient()->GetRollbackCount();
+		client->GetGameClient()->Disconnect();
+		host->GetGameServer()->StopServer();
+	}
+
+	client->Stop(false, true, false);
+	host->Stop(false, true, false);
+
+	//Compare every frame the client ran after it was synced with the server
+	unordered_map<uint32_t, uint32_t> hostHashes = hostFrames->GetHashes();
+	unordered_map<uint32_t, uint32_t> clientHashes = clientFrames->GetHashes();
+	uint32_t comparedFrames = 0;
+	int64_t firstMismatch = -1;
+	for(auto& [frame, hash] : clientHashes) {
+		auto result = hostHashes.find(frame);
+		if(result != hostHashes.end()) {
+			comparedFrames++;
+			if(result->second != hash && (firstMismatch < 0 || frame < firstMismatch)) {
+				firstMismatch = frame;
+			}
+		}
+	}
+
+	client->Release();
+	host->Release();
+
+	//The server emulates each frame once, with the actual input: the client's frames (after its rollbacks) must match it.
+	//With rollback enabled, the test fails if the client never had to roll back (the rollback path wasn't tested)
+	bool match = loaded && comparedFrames > 0 && firstMismatch < 0 && (rollbackFrames == 0 || rollbackCount > 0);
+	out << "{\n";
+	out << "  \"rom\": \"" << BatchRunner::EscapeJson(file) << "\",\n";
+	out << "  \"loaded\": " << (loaded ? "true" : "false") << ",\n";
+	out << "  \"connected\": " << (connected ? "true" : "false") << ",\n";
+	out << "  \"rollbackFrames\": " << rollbackFrames << ",\n";
+	out << "  \"rollbacks\": " << rollbackCount << ",\n";
+	out << "  \"comparedFrames\": " << comparedFrames << ",\n";
+	out << "  \"firstMismatchFrame\": " << firstMismatch << ",\n";
+	out << "  \"match\": " << (match ? "true" : "false") << "\n";
+	out << "}\n";
+
+	return match ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	BatchRunOptions options;
+	vector<string> files;
+	uint32_t threadCount = 0;
+	bool useFarm = false;
+	string homeFolder = "MesenHeadless";
+	string outputFile;
+	bool printLog = false;
+	bool compareClock = false;
+	bool compareCoprocSync = false;
+	int32_t loopbackPort = -1;
+	uint32_t rollbackFrames = 8;
+
+	for(int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		try {
+			if(arg == "--frames" && hasValue) {
+				options.FrameCount = (uint32_t)std::stoul(argv[++i]);
+			} else if(arg == "--movie" && hasValue) {
+				options.MovieFile = argv[++i];
+			} else if(arg == "--script" && hasValue) {
+				options.ScriptFile = argv[++i];
+			} else if(arg == "--patch" && hasValue) {
+				options.PatchFile = argv[++i];
+			} else if(arg == "--timeout" && hasValue) {
+				options.Timeout = (uint32_t)(std::stod(argv[++i]) * 1000);
+			} else if(arg == "--threads" && hasValue) {
+				threadCount = (uint32_t)std::stoul(argv[++i]);
+				useFarm = true;
+			} else if(arg == "--home" && hasValue) {
+				homeFolder = argv[++i];
+			} else if(arg == "--output" && hasValue) {
+				outputFile = argv[++i];
+			} else if(arg == "--hashes") {
+				options.RecordFrameHashes = true;
+			} else if(arg == "--log") {
+				printLog = true;
+			} else if(arg == "--compare-clock") {
+				compareClock = true;
+			} else if(arg == "--compare-coproc-sync") {
+				compareClock = true;
+				compareCoprocSync = true;
+			} else if(arg == "--netplay-loopback" && hasValue) {
+				loopbackPort = (int32_t)std::stoul(argv[++i]);
+			} else if(arg == "--rollback" && hasValue) {
+				rollbackFrames = (uint32_t)std::stoul(argv[++i]);
+			} else if(arg == "--dump" && hasValue) {
+				BatchMemoryRegion region = {};
+				if(!ParseMemoryRegion(argv[++i], region)) {
+					std::cerr << "Invalid memory region: " << argv[i] << std::endl;
+					return -1;
+				}
+				options.MemoryRegions.push_back(region);
+			} else if(arg.size() > 0 && arg[0] != '-') {
+				files.push_back(arg);
+			} else {
+				PrintUsage();
+				return -1;
+			}
+		} catch(std::exception&) {
+			std::cerr << "Invalid value for " << arg << std::endl;
+			return -1;
+		}
+	}
+
+	bool hasRoms = false;
+	for(string& file : files) {
+		hasRoms |= FolderUtilities::GetExtension(file) != ".mtp";
+	}
+
+	if(files.empty() || (hasRoms && options.FrameCount == 0 && options.MovieFile.empty() && options.ScriptFile.empty() && options.Timeout == 0)) {
+		//Refuse to run forever (recorded tests end on their own)
+		PrintUsage();
+		return -1;
+	}
+
+	FolderUtilities::SetHomeFolder(homeFolder);
+
+	ofstream outFile;
+	if(!outputFile.empty()) {
+		outFile.open(outputFile, ios::out | ios::binary);
+	}
+	ostream& out = outputFile.empty() ? std::cout : outFile;
+
+	int exitCode;
+	if(loopbackPort >= 0) {
+		if(files.size() != 1 || !hasRoms || options.FrameCount == 0) {
+			std::cerr << "--netplay-loopback requires a single rom and --frames" << std::endl;
+			return -1;
+		}
+		exitCode = RunNetplayLoopback(files[0], options, (uint16_t)loopbackPort, rollbackFrames, out);
+	} else if(compareClock) {
+		exitCode = RunClockComparison(files, options, threadCount, compareCoprocSync, out);
+	} else if(useFarm || files.size() > 1 || !hasRoms) {
+		exitCode = RunFarm(files, options, threadCount, out);
+	} else {
+		options.RomFile = files[0];
+
+		unique_ptr<Emulator> emu(new Emulator());
+		emu->Initialize(false, true);
+
+		shared_ptr<BatchRunner> runner(new BatchRunner(emu.get()));
+		BatchRunResult result = runner->Run(options);
+
+		emu->Release();
+
+		BatchRunner::WriteJson(out, options, result);
+
+		switch(result.StopReason) {
+			case BatchStopReason::LoadFailed: exitCode = -2; break;
+			case BatchStopReason::Timeout: exitCode = -3; break;
+			default: exitCode = result.StopCode; break;
+		}
+	}
+
+	if(printLog) {
+		std::cerr << MessageManager::GetLog();
+	}
+
+	return exitCode;
+}
@@ -20,6 +20,7 @@
 #include "Core/Debugger/BaseEventManager.h"
 #include "Core/Debugger/ITraceLogger.h"
 #include "Core/Debugger/TraceLogFileSaver.h"
+#include "Core/Debugger/TraceStore.h"
 #include "Core/Debugger/FrozenAddressManager.h"
 #include "Core/Gameboy/GbTypes.h"
 #include "Utilities/StringUtilities.h"
@@ -81,8 +82,17 @@ extern "C"
 	DllExport uint32_t __stdcall GetExecutionTrace(TraceRow output[], uint32_t startOffset, uint32_t lineCount) { return WithDebugger(uint32_t, GetExecutionTrace(output, startOffset, lineCount)); }
 	DllExport void __stdcall ClearExecutionTrace() { WithDebugger(void, ClearExecutionTrace()); }
 
-	DllExport void __stdcall StartLogTraceToFile(const char* filename) { WithDebugger(void, GetTraceLogFileSaver()->StartLogging(filename)); }
+	DllExport void __stdcall StartLogTraceToFile(const char* filename, bool binary) { WithDebugger(void, GetTraceLogFileSaver()->StartLogging(filename, binary)); }
 	DllExport void __stdcall StopLogTraceToFile() { WithDebugger(void, GetTraceLogFileSaver()->StopLogging()); }
+	DllExport bool __stdcall ConvertTraceLogToText(const char* binaryFile, const char* textFile) { return WithDebugger(bool, GetTraceLogFileSaver()->ConvertToText(binaryFile, textFile)); }
+
+	DllExport bool __stdcall StartTraceStore(const char* filename) { return WithDebugger(bool, GetTraceStore()->Start(filename)); }
+	DllExport void __stdcall StopTraceStore() { WithDebugger(void, GetTraceStore()->Stop()); }
+	DllExport void __stdcall ClearTraceStore() { WithDebugger(void, GetTraceStore()->Clear()); }
+	DllExport uint64_t __stdcall GetTraceStoreRowCount() { return WithDebugger(uint64_t, GetTraceStore()->GetRowCount()); }
+	DllExport int64_t __stdcall FindTraceStoreRow(uint32_t frame, int32_t scanline) { return WithDebugger(int64_t, GetTraceStore()->FindRow(frame, scanline)); }
+	DllExport uint32_t __stdcall SearchTraceStore(TraceStoreFilter filter, uint64_t startRow, uint64_t results[], uint32_t maxResults) { return WithDebugger(uint32_t, GetTraceStore()->Search(filter, startRow, results, maxResults)); }
+	DllExport uint32_t __stdcall GetTraceStoreRows(uint64_t startRow, TraceRow output[], uint32_t rowCount) { return WithDebugger(uint32_t, GetTraceStore()->GetRows(startRow, output, rowCount)); }
 
 	DllExport void __stdcall SetBreakpoints(Breakpoint breakpoints[], uint32_t length) { WithDebugger(void, SetBreakpoints(breakpoints, length)); }
 	
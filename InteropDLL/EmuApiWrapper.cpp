@@ -70,7 +70,6 @@ extern "C" {
 	DllExport void __stdcall InitDll()
 	{
 		_emu->Initialize();
-		KeyManager::SetSettings(_emu->GetSettings());
 	}
 
 	DllExport void __stdcall InitializeEmu(const char* homeFolder, void *windowHandle, void *viewerHandle, bool softwareRenderer, bool noAudio, bool noVideo, bool noInput)
@@ -113,7 +112,7 @@ extern "C" {
 					_keyManager.reset(new LinuxKeyManager(_emu.get()));
 				#endif
 					
-				KeyManager::RegisterKeyManager(_keyManager.get());
+				_emu->GetKeyManager()->RegisterKeyManager(_keyManager.get());
 			}
 		}
 	}
@@ -309,12 +308,11 @@ extern "C" {
 	{
 		FolderUtilities::SetHomeFolder("../PGOMesenHome");
 		PgoKeyManager pgoKeyManager;
-		KeyManager::RegisterKeyManager(&pgoKeyManager);
+		_emu->GetKeyManager()->RegisterKeyManager(&pgoKeyManager);
 
 		for(size_t i = 0; i < testRoms.size(); i++) {
 			std::cout << "Running: " << testRoms[i] << std::endl;
 
-			KeyManager::SetSettings(_emu->GetSettings());
 			_emu->Initialize();
 
 			//Map key #10 to the start button for all consoles - this key is toggled on/off every 4 frames
@@ -12,12 +12,12 @@ extern "C"
 {
 	DllExport void __stdcall SetMousePosition(double x, double y)
 	{
-		KeyManager::SetMousePosition(_emu.get(), x, y);
+		_emu->GetKeyManager()->SetMousePosition(x, y);
 	}
 
 	DllExport void __stdcall SetMouseMovement(int16_t x, int16_t y)
 	{
-		KeyManager::SetMouseMovement(x, y);
+		_emu->GetKeyManager()->SetMouseMovement(x, y);
 	}
 
 	DllExport void __stdcall UpdateInputDevices()
@@ -29,7 +29,7 @@ extern "C"
 
 	DllExport void __stdcall GetPressedKeys(uint16_t* keyBuffer)
 	{
-		vector<uint16_t> pressedKeys = KeyManager::GetPressedKeys();
+		vector<uint16_t> pressedKeys = _emu->GetKeyManager()->GetPressedKeys();
 		for(size_t i = 0; i < pressedKeys.size() && i < 3; i++) {
 			keyBuffer[i] = pressedKeys[i];
 		}
@@ -60,13 +60,13 @@ extern "C"
 
 	DllExport void __stdcall GetKeyName(uint16_t keyCode, char* outKeyName, uint32_t maxLength)
 	{
-		StringUtilities::CopyToBuffer(KeyManager::GetKeyName(keyCode), outKeyName, maxLength);
+		StringUtilities::CopyToBuffer(_emu->GetKeyManager()->GetKeyName(keyCode), outKeyName, maxLength);
 	}
 
 	DllExport uint16_t __stdcall GetKeyCode(char* keyName)
 	{
 		if(keyName) {
-			return KeyManager::GetKeyCode(keyName);
+			return _emu->GetKeyManager()->GetKeyCode(keyName);
 		} else {
 			return 0;
 		}
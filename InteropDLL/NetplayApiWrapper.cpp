@@ -12,9 +12,9 @@ extern "C" {
 	DllExport void __stdcall StopServer() { _emu->GetGameServer()->StopServer(); }
 	DllExport bool __stdcall IsServerRunning() { return _emu->GetGameServer()->Started(); }
 
-	DllExport void __stdcall Connect(char* host, uint16_t port, char* password, bool spectator)
+	DllExport void __stdcall Connect(char* host, uint16_t port, char* password, bool spectator, uint32_t maxRollbackFrames)
 	{
-		ClientConnectionData connectionData(host, port, password, spectator);
+		ClientConnectionData connectionData(host, port, password, spectator, maxRollbackFrames);
 		_emu->GetGameClient()->Connect(connectionData);
 	}
 
@@ -8,6 +8,7 @@ namespace Mesen.Config
 		[Reactive] public string Host { get; set; } = "localhost";
 		[Reactive] public UInt16 Port { get; set; } = 8888;
 		[Reactive] public string Password { get; set; } = "";
+		[Reactive] public UInt32 MaxRollbackFrames { get; set; } = 0;
 
 		[Reactive] public UInt16 ServerPort { get; set; } = 8888;
 		[Reactive] public string ServerPassword { get; set; } = "";
@@ -54,6 +54,7 @@ namespace Mesen.Config
 		[Reactive] public FullscreenResolution ExclusiveFullscreenResolution { get; set; } = 0;
 
 		[Reactive] public ScreenRotation ScreenRotation { get; set; } = ScreenRotation.None;
+		[Reactive] [MinMax(0, 32)] public UInt32 FilterThreadCount { get; set; } = 0;
 
 		public VideoConfig()
 		{
@@ -102,7 +103,8 @@ namespace Mesen.Config
 				FullscreenResWidth = (uint)(ExclusiveFullscreenResolution == FullscreenResolution.Default ? (ApplicationHelper.GetMainWindow()?.Screens.Primary?.Bounds.Width ?? 1920) : ExclusiveFullscreenResolution.GetWidth()),
 				FullscreenResHeight = (uint)(ExclusiveFullscreenResolution == FullscreenResolution.Default ? (ApplicationHelper.GetMainWindow()?.Screens.Primary?.Bounds.Height ?? 1080) : ExclusiveFullscreenResolution.GetHeight()),
 
-				ScreenRotation = (uint)ScreenRotation
+				ScreenRotation = (uint)ScreenRotation,
+				FilterThreadCount = this.FilterThreadCount
 			});
 		}
 	}
@@ -151,6 +153,7 @@ namespace Mesen.Config
 		public UInt32 FullscreenResHeight;
 
 		public UInt32 ScreenRotation;
+		public UInt32 FilterThreadCount;
 	}
 
 	public enum VideoFilterType
@@ -13,6 +13,7 @@ namespace Mesen.Config
 		[Reactive] public UInt32 CompressionLevel { get; set; } = 6;
 		[Reactive] public bool RecordSystemHud { get; set; } = false;
 		[Reactive] public bool RecordInputHud { get; set; } = false;
+		[Reactive] public RecordFramePolicy FramePolicy { get; set; } = RecordFramePolicy.Block;
 	}
 
 	public enum VideoCodec
@@ -22,4 +23,11 @@ namespace Mesen.Config
 		CSCD = 2,
 		GIF = 3
 	}
+
+	public enum RecordFramePolicy
+	{
+		Block = 0,
+		Drop = 1,
+		Grow = 2
+	}
 }
@@ -55,6 +55,8 @@ namespace Mesen.Interop
 		MaximumSpeed = 0x04,
 		InBackground = 0x08,
 		ConsoleMode = 0x10,
+		DisableClockScheduler = 0x20,
+		BatchCoprocessorSync = 0x40,
 	}
 
 	public enum DebuggerFlags : UInt32
@@ -22,8 +22,38 @@ namespace Mesen.Interop
 		[DllImport(DllPath)] public static extern void ResumeExecution();
 		[DllImport(DllPath)] public static extern void Step(CpuType cpuType, Int32 instructionCount, StepType type = StepType.Step);
 
-		[DllImport(DllPath)] public static extern void StartLogTraceToFile([MarshalAs(UnmanagedType.LPUTF8Str)] string filename);
+		[DllImport(DllPath)] public static extern void StartLogTraceToFile([MarshalAs(UnmanagedType.LPUTF8Str)] string filename, [MarshalAs(UnmanagedType.I1)] bool binary = false);
 		[DllImport(DllPath)] public static extern void StopLogTraceToFile();
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool ConvertTraceLogToText([MarshalAs(UnmanagedType.LPUTF8Str)] string binaryFile, [MarshalAs(UnmanagedType.LPUTF8Str)] string textFile);
+
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool StartTraceStore([MarshalAs(UnmanagedType.LPUTF8Str)] string filename);
+		[DllImport(DllPath)] public static extern void StopTraceStore();
+		[DllImport(DllPath)] public static extern void ClearTraceStore();
+		[DllImport(DllPath)] public static extern UInt64 GetTraceStoreRowCount();
+		[DllImport(DllPath)] public static extern Int64 FindTraceStoreRow(UInt32 frame, Int32 scanline);
+
+		[DllImport(DllPath)] private static extern UInt32 SearchTraceStore(TraceStoreFilter filter, UInt64 startRow, [In, Out] UInt64[] results, UInt32 maxResults);
+		public static UInt64[] SearchTraceStore(TraceStoreFilter filter, UInt64 startRow, UInt32 maxResults)
+		{
+			UInt64[] results = new UInt64[maxResults];
+			UInt32 count = DebugApi.SearchTraceStore(filter, startRow, results, maxResults);
+			Array.Resize(ref results, (int)count);
+			return results;
+		}
+
+		[DllImport(DllPath, EntryPoint = "GetTraceStoreRows")] private static extern UInt32 GetTraceStoreRowsWrapper(UInt64 startRow, IntPtr output, UInt32 maxRowCount);
+		public static unsafe TraceRow[] GetTraceStoreRows(UInt64 startRow, UInt32 maxRowCount)
+		{
+			TraceRow[] rows = new TraceRow[maxRowCount];
+
+			UInt32 rowCount;
+			fixed(TraceRow* ptr = rows) {
+				rowCount = DebugApi.GetTraceStoreRowsWrapper(startRow, (IntPtr)ptr, maxRowCount);
+			}
+
+			Array.Resize(ref rows, (int)rowCount);
+			return rows;
+		}
 
 		[DllImport(DllPath)] public static extern void SetTraceOptions(CpuType cpuType, InteropTraceLoggerOptions options);
 
@@ -1529,6 +1559,20 @@ namespace Mesen.Interop
 		}
 	}
 
+	public struct TraceStoreFilter
+	{
+		[MarshalAs(UnmanagedType.I1)] public bool FilterCpu;
+		public CpuType Cpu;
+
+		[MarshalAs(UnmanagedType.I1)] public bool FilterPc;
+		public UInt32 PcStart;
+		public UInt32 PcEnd;
+
+		[MarshalAs(UnmanagedType.I1)] public bool FilterAddress;
+		public Int32 AddressStart;
+		public Int32 AddressEnd;
+	}
+
 	public unsafe struct TraceRow
 	{
 		public UInt32 ProgramCounter;
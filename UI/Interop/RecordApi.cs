@@ -75,6 +75,7 @@ namespace Mesen.Interop
 		public UInt32 CompressionLevel;
 		[MarshalAs(UnmanagedType.I1)] public bool RecordSystemHud;
 		[MarshalAs(UnmanagedType.I1)] public bool RecordInputHud;
+		public RecordFramePolicy FramePolicy;
 	};
 
 }
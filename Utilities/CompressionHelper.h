@@ -1,44 +1,93 @@
 #pragma once
 #include "pch.h"
 #include "miniz.h"
+#include "Utilities/Lz4.h"
+
+enum class CompressionCodec : uint8_t
+{
+	//Default, used for anything written to disk/sent over the network
+	Deflate = 0,
+
+	//Fast codec, used for data that only lives in memory (e.g rewind history)
+	Lz4 = 1
+};
 
 class CompressionHelper
 {
+private:
+	//The codec is stored in the top byte of the original size field (data created before codecs were added has 0 = deflate)
+	static constexpr uint32_t CodecShift = 24;
+	static constexpr uint32_t SizeMask = (1 << CodecShift) - 1;
+	static constexpr uint32_t MaxSize = 1024 * 1024 * 10;
+
 public:
-	static void Compress(string data, int compressionLevel, vector<uint8_t>& output)
+	static void CompressBlock(CompressionCodec codec, uint8_t* data, uint32_t dataSize, int compressionLevel, vector<uint8_t>& output)
+	{
+		size_t start = output.size();
+		if(codec == CompressionCodec::Lz4) {
+			output.resize(start + Lz4::GetMaxCompressedSize(dataSize));
+			uint32_t compressedSize = Lz4::Compress(data, dataSize, output.data() + start, (uint32_t)(output.size() - start));
+			output.resize(start + compressedSize);
+		} else {
+			unsigned long compressedSize = compressBound((unsigned long)dataSize);
+			output.resize(start + compressedSize);
+			compress2(output.data() + start, &compressedSize, data, (unsigned long)dataSize, compressionLevel);
+			output.resize(start + compressedSize);
+		}
+	}
+
+	static bool DecompressBlock(CompressionCodec codec, uint8_t* data, uint32_t dataSize, uint8_t* output, uint32_t outputSize)
+	{
+		switch(codec) {
+			case CompressionCodec::Deflate: {
+				unsigned long decompSize = outputSize;
+				return uncompress(output, &decompSize, data, (unsigned long)dataSize) == MZ_OK && decompSize == outputSize;
+			}
+
+			case CompressionCodec::Lz4:
+				return Lz4::Decompress(data, dataSize, output, outputSize);
+		}
+		return false;
+	}
+
+	static void Compress(string data, int compressionLevel, vector<uint8_t>& output, CompressionCodec codec = CompressionCodec::Deflate)
 	{
-		unsigned long compressedSize = compressBound((unsigned long)data.size());
-		uint8_t* compressedData = new uint8_t[compressedSize];
-		compress2(compressedData, &compressedSize, (unsigned char*)data.c_str(), (unsigned long)data.size(), compressionLevel);
-
-		uint32_t size = (uint32_t)compressedSize;
-		uint32_t originalSize = (uint32_t)data.size();
-		output.insert(output.end(), (char*)&originalSize, (char*)&originalSize + sizeof(uint32_t));
-		output.insert(output.end(), (char*)&size, (char*)&size + sizeof(uint32_t));
-		output.insert(output.end(), (char*)compressedData, (char*)compressedData + compressedSize);
-		delete[] compressedData;
+		Compress((uint8_t*)data.c_str(), (uint32_t)data.size(), compressionLevel, output, codec);
+	}
+
+	static void Compress(uint8_t* data, uint32_t dataSize, int compressionLevel, vector<uint8_t>& output, CompressionCodec codec = CompressionCodec::Deflate)
+	{
+		size_t headerPos = output.size();
+		output.resize(headerPos + sizeof(uint32_t) * 2);
+		CompressBlock(codec, data, dataSize, compressionLevel, output);
+
+		uint32_t size = (uint32_t)(output.size() - headerPos - sizeof(uint32_t) * 2);
+		uint32_t originalSize = dataSize | ((uint32_t)codec << CodecShift);
+		memcpy(output.data() + headerPos, &originalSize, sizeof(uint32_t));
+		memcpy(output.data() + headerPos + sizeof(uint32_t), &size, sizeof(uint32_t));
 	}
 
 	static bool Decompress(vector<uint8_t>& input, vector<uint8_t>& output)
 	{
+		if(input.size() < sizeof(uint32_t) * 2) {
+			return false;
+		}
+
 		uint32_t decompressedSize;
 		uint32_t compressedSize;
 
 		memcpy(&decompressedSize, input.data(), sizeof(uint32_t));
 		memcpy(&compressedSize, input.data() + sizeof(uint32_t), sizeof(uint32_t));
 
-		if(decompressedSize >= 1024 * 1024 * 10 || compressedSize >= 1024 * 1024 * 10) {
+		CompressionCodec codec = (CompressionCodec)(decompressedSize >> CodecShift);
+		decompressedSize &= SizeMask;
+
+		if(decompressedSize >= MaxSize || compressedSize >= MaxSize) {
 			//Limit to 10mb the data's size
 			return false;
 		}
 
 		output.resize(decompressedSize, 0);
-
-		unsigned long decompSize = decompressedSize;
-		if(uncompress(output.data(), &decompSize, input.data() + sizeof(uint32_t)*2, (unsigned long)input.size() - sizeof(uint32_t) * 2) != MZ_OK) {
-			return false;
-		}
-
-		return true;
+		return DecompressBlock(codec, input.data() + sizeof(uint32_t) * 2, (uint32_t)input.size() - sizeof(uint32_t) * 2, output.data(), decompressedSize);
 	}
-};
\ No newline at end of file
+};
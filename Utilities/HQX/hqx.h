@@ -44,14 +44,15 @@
 #endif
 
 void HQX_CALLCONV hqxInit(void);
-void HQX_CALLCONV hqx(uint32_t scale, uint32_t * src, uint32_t * dest, int width, int height);
+//yFirst/yLast: range of source rows to process - slices of the same image can be processed on multiple threads
+void HQX_CALLCONV hqx(uint32_t scale, uint32_t * src, uint32_t * dest, int width, int height, int yFirst = 0, int yLast = INT32_MAX);
 
 void HQX_CALLCONV hq2x_32( uint32_t * src, uint32_t * dest, int width, int height );
 void HQX_CALLCONV hq3x_32( uint32_t * src, uint32_t * dest, int width, int height );
 void HQX_CALLCONV hq4x_32( uint32_t * src, uint32_t * dest, int width, int height );
 
-void HQX_CALLCONV hq2x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height );
-void HQX_CALLCONV hq3x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height );
-void HQX_CALLCONV hq4x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height );
+void HQX_CALLCONV hq2x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
+void HQX_CALLCONV hq3x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
+void HQX_CALLCONV hq4x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
 
 #endif
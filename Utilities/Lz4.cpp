@@ -0,0 +1,201 @@
+#include "pch.h"
+#include "Utilities/Lz4.h"
+
+uint32_t Lz4::Read32(const uint8_t* src)
+{
+	uint32_t value;
+	memcpy(&value, src, sizeof(value));
+	return value;
+}
+
+uint64_t Lz4::Read64(const uint8_t* src)
+{
+	uint64_t value;
+	memcpy(&value, src, sizeof(value));
+	return value;
+}
+
+uint32_t Lz4::Hash(uint32_t value)
+{
+	return (value * 2654435761U) >> (32 - HashLog);
+}
+
+uint32_t Lz4::GetMaxCompressedSize(uint32_t srcSize)
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+void Lz4::WriteLength(uint8_t*& out, uint32_t length)
+{
+	while(length >= 255) {
+		*out++ = 255;
+		length -= 255;
+	}
+	*out++ = (uint8_t)length;
+}
+
+void Lz4::WriteSequence(uint8_t*& out, const uint8_t* literals, uint32_t literalLength, uint32_t offset, uint32_t matchLength)
+{
+	uint8_t* token = out++;
+	if(literalLength >= 15) {
+		*token = 0xF0;
+		WriteLength(out, literalLength - 15);
+	} else {
+		*token = (uint8_t)(literalLength << 4);
+	}
+
+	if(literalLength > 0) {
+		memcpy(out, literals, literalLength);
+		out += literalLength;
+	}
+
+	if(matchLength == 0) {
+		//Last sequence only contains literals
+		return;
+	}
+
+	*out++ = (uint8_t)offset;
+	*out++ = (uint8_t)(offset >> 8);
+
+	matchLength -= MinMatch;
+	if(matchLength >= 15) {
+		*token |= 0x0F;
+		WriteLength(out, matchLength - 15);
+	} else {
+		*token |= (uint8_t)matchLength;
+	}
+}
+
+uint32_t Lz4::Compress(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstCapacity)
+{
+	if(dstCapacity < GetMaxCompressedSize(srcSize)) {
+		return 0;
+	}
+
+	uint8_t* out = dst;
+	uint32_t anchor = 0;
+
+	if(srcSize > MatchFindLimit) {
+		uint32_t hashTable[1 << HashLog] = {};
+		uint32_t matchLimit = srcSize - LastLiterals;
+		uint32_t findLimit = srcSize - MatchFindLimit;
+		uint32_t pos = 0;
+		uint32_t searchCount = 1 << SkipTrigger;
+
+		while(pos < findLimit) {
+			uint32_t value = Read32(src + pos);
+			uint32_t hash = Hash(value);
+			uint32_t ref = hashTable[hash];
+			hashTable[hash] = pos;
+
+			if(ref >= pos || pos - ref > MaxDistance || Read32(src + ref) != value) {
+				//Step further ahead the longer we go without finding a match (makes incompressible data faster to process)
+				pos += searchCount++ >> SkipTrigger;
+				continue;
+			}
+
+			//Extend the match backwards into the pending literals
+			while(pos > anchor && ref > 0 && src[pos - 1] == src[ref - 1]) {
+				pos--;
+				ref--;
+			}
+
+			uint32_t matchLength = MinMatch;
+			while(pos + matchLength + 8 <= matchLimit && Read64(src + pos + matchLength) == Read64(src + ref + matchLength)) {
+				matchLength += 8;
+			}
+			while(pos + matchLength < matchLimit && src[pos + matchLength] == src[ref + matchLength]) {
+				matchLength++;
+			}
+
+			WriteSequence(out, src + anchor, pos - anchor, pos - ref, matchLength);
+
+			pos += matchLength;
+			anchor = pos;
+			searchCount = 1 << SkipTrigger;
+
+			if(pos < findLimit) {
+				hashTable[Hash(Read32(src + pos - 2))] = pos - 2;
+			}
+		}
+	}
+
+	WriteSequence(out, src + anchor, srcSize - anchor, 0, 0);
+	return (uint32_t)(out - dst);
+}
+
+bool Lz4::ReadLength(const uint8_t*& in, const uint8_t* inEnd, uint32_t& length)
+{
+	uint8_t value;
+	do {
+		if(in >= inEnd) {
+			return false;
+		}
+		value = *in++;
+		length += value;
+	} while(value == 255);
+	return true;
+}
+
+bool Lz4::Decompress(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize)
+{
+	const uint8_t* in = src;
+	const uint8_t* inEnd = src + srcSize;
+	uint8_t* out = dst;
+	uint8_t* outEnd = dst + dstSize;
+
+	while(in < inEnd) {
+		uint8_t token = *in++;
+
+		uint32_t literalLength = token >> 4;
+		if(literalLength == 15 && !ReadLength(in, inEnd, literalLength)) {
+			return false;
+		}
+
+		if(literalLength > (size_t)(inEnd - in) || literalLength > (size_t)(outEnd - out)) {
+			return false;
+		}
+		if(literalLength > 0) {
+			memcpy(out, in, literalLength);
+			in += literalLength;
+			out += literalLength;
+		}
+
+		if(in == inEnd) {
+			//Last sequence has no match
+			break;
+		}
+
+		if(inEnd - in < 2) {
+			return false;
+		}
+		uint32_t offset = in[0] | (in[1] << 8);
+		in += 2;
+		if(offset == 0 || offset > (size_t)(out - dst)) {
+			return false;
+		}
+
+		uint32_t matchLength = token & 0x0F;
+		if(matchLength == 15 && !ReadLength(in, inEnd, matchLength)) {
+			return false;
+		}
+		matchLength += MinMatch;
+
+		if(matchLength > (size_t)(outEnd - out)) {
+			return false;
+		}
+
+		uint8_t* match = out - offset;
+		if(offset >= matchLength) {
+			memcpy(out, match, matchLength);
+			out += matchLength;
+		} else {
+			//Overlapping copy (repeating pattern), must be done byte by byte
+			for(uint32_t i = 0; i < matchLength; i++) {
+				*out++ = *match++;
+			}
+		}
+	}
+
+	return out == outEnd;
+}
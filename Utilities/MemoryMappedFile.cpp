@@ -0,0 +1,140 @@
+#include "pch.h"
+#include "MemoryMappedFile.h"
+#include "UTF8Util.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+bool MemoryMappedFile::Open(string filename)
+{
+	Close();
+
+	#ifdef _WIN32
+	HANDLE file = CreateFileW(utf8::utf8::decode(filename).c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	_file = file;
+	#else
+	_file = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(_file < 0) {
+		return false;
+	}
+	#endif
+
+	_filename = filename;
+	_size = 0;
+	return true;
+}
+
+void MemoryMappedFile::Close(bool deleteFile)
+{
+	if(!IsOpen()) {
+		return;
+	}
+
+	#ifdef _WIN32
+	CloseHandle((HANDLE)_file);
+	_file = nullptr;
+	if(deleteFile) {
+		DeleteFileW(utf8::utf8::decode(_filename).c_str());
+	}
+	#else
+	close(_file);
+	_file = -1;
+	if(deleteFile) {
+		unlink(_filename.c_str());
+	}
+	#endif
+
+	_size = 0;
+}
+
+bool MemoryMappedFile::IsOpen()
+{
+	#ifdef _WIN32
+	return _file != nullptr;
+	#else
+	return _file >= 0;
+	#endif
+}
+
+bool MemoryMappedFile::SetSize(uint64_t size)
+{
+	if(!IsOpen()) {
+		return false;
+	}
+
+	#ifdef _WIN32
+	LARGE_INTEGER pos;
+	pos.QuadPart = (LONGLONG)size;
+	if(!SetFilePointerEx((HANDLE)_file, pos, nullptr, FILE_BEGIN) || !SetEndOfFile((HANDLE)_file)) {
+		return false;
+	}
+	#else
+	if(ftruncate(_file, (off_t)size) != 0) {
+		return false;
+	}
+	#endif
+
+	_size = size;
+	return true;
+}
+
+uint8_t* MemoryMappedFile::Map(uint64_t offset, uint32_t length)
+{
+	if(!IsOpen() || offset + length > _size) {
+		return nullptr;
+	}
+
+	#ifdef _WIN32
+	//The view keeps the mapping object alive, so it can be closed right away
+	uint64_t mappingSize = offset + length;
+	HANDLE mapping = CreateFileMappingW((HANDLE)_file, nullptr, PAGE_READWRITE, (DWORD)(mappingSize >> 32), (DWORD)mappingSize, nullptr);
+	if(!mapping) {
+		return nullptr;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, (DWORD)(offset >> 32), (DWORD)offset, length);
+	CloseHandle(mapping);
+	return (uint8_t*)view;
+	#else
+	void* view = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, _file, (off_t)offset);
+	return view == MAP_FAILED ? nullptr : (uint8_t*)view;
+	#endif
+}
+
+void MemoryMappedFile::Unmap(uint8_t* view, uint32_t length)
+{
+	if(!view) {
+		return;
+	}
+
+	#ifdef _WIN32
+	UnmapViewOfFile(view);
+	#else
+	munmap(view, length);
+	#endif
+}
+
+uint32_t MemoryMappedFile::GetViewAlignment()
+{
+	#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwAllocationGranularity;
+	#else
+	return (uint32_t)sysconf(_SC_PAGESIZE);
+	#endif
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "pch.h"
+
+//Read/write file that can be grown and mapped into memory in several separate views
+class MemoryMappedFile
+{
+private:
+	#ifdef _WIN32
+	void* _file = nullptr;
+	#else
+	int _file = -1;
+	#endif
+
+	string _filename;
+	uint64_t _size = 0;
+
+public:
+	~MemoryMappedFile();
+
+	//Creates (or truncates) the file
+	bool Open(string filename);
+	void Close(bool deleteFile = false);
+
+	bool IsOpen();
+	uint64_t GetSize() { return _size; }
+	bool SetSize(uint64_t size);
+
+	//Offset must be a multiple of GetViewAlignment()
+	uint8_t* Map(uint64_t offset, uint32_t length);
+	static void Unmap(uint8_t* view, uint32_t length);
+	static uint32_t GetViewAlignment();
+};
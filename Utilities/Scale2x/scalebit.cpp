@@ -471,3 +471,51 @@ void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_
 	}
 }
 
+/**
+ * Apply the Scale2x/Scale3x effect on a range of rows of a bitmap.
+ * The output is identical to the matching rows produced by ::scale(), which allows
+ * multiple threads to process separate row ranges of the same bitmap.
+ * Scale4x is not supported, apply Scale2x twice instead (via an intermediate buffer).
+ * \param scale Scale factor. 2, 203 (for 2x3), 204 (for 2x4) or 3.
+ * \param void_dst Pointer at the first pixel of the destination bitmap.
+ * \param dst_slice Size in bytes of a destination bitmap row.
+ * \param void_src Pointer at the first pixel of the source bitmap.
+ * \param src_slice Size in bytes of a source bitmap row.
+ * \param pixel Bytes per pixel of the source and destination bitmap.
+ * \param width Horizontal size in pixels of the source bitmap.
+ * \param height Vertical size in pixels of the source bitmap.
+ * \param y_first First source row to process.
+ * \param y_last Source row after the last row to process.
+ */
+void scale_slice(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height, unsigned y_first, unsigned y_last)
+{
+	unsigned char* dst = (unsigned char*)void_dst;
+	const unsigned char* src = (const unsigned char*)void_src;
+	unsigned y;
+
+	if (y_last > height)
+		y_last = height;
+
+	for (y = y_first; y < y_last; y++) {
+		const unsigned char* src0 = src + (y > 0 ? y - 1 : 0) * src_slice;
+		const unsigned char* src1 = src + y * src_slice;
+		const unsigned char* src2 = src + (y + 1 < height ? y + 1 : y) * src_slice;
+
+		switch (scale) {
+		case 202 :
+		case 2 :
+			stage_scale2x(dst + (y*2)*dst_slice, dst + (y*2+1)*dst_slice, src0, src1, src2, pixel, width);
+			break;
+		case 203 :
+			stage_scale2x3(dst + (y*3)*dst_slice, dst + (y*3+1)*dst_slice, dst + (y*3+2)*dst_slice, src0, src1, src2, pixel, width);
+			break;
+		case 204 :
+			stage_scale2x4(dst + (y*4)*dst_slice, dst + (y*4+1)*dst_slice, dst + (y*4+2)*dst_slice, dst + (y*4+3)*dst_slice, src0, src1, src2, pixel, width);
+			break;
+		case 303 :
+		case 3 :
+			stage_scale3x(dst + (y*3)*dst_slice, dst + (y*3+1)*dst_slice, dst + (y*3+2)*dst_slice, src0, src1, src2, pixel, width);
+			break;
+		}
+	}
+}
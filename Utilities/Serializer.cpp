@@ -2,7 +2,7 @@
 #include <algorithm>
 #include "Serializer.h"
 #include "ISerializable.h"
-#include "miniz.h"
+#include "CompressionHelper.h"
 
 Serializer::Serializer(uint32_t version, bool forSave, SerializeFormat format)
 {
@@ -14,10 +14,57 @@ Serializer::Serializer(uint32_t version, bool forSave, SerializeFormat format)
 			case SerializeFormat::Binary: _data.reserve(0x50000); break;
 			case SerializeFormat::Map: _mapValues.reserve(500); break;
 			case SerializeFormat::Text: _values.reserve(500); break;
+			case SerializeFormat::Schema: break; //Uses the schema constructor
 		}
 	}
 }
 
+void SerializerSchema::AddField(string& key, uint32_t size)
+{
+	//The layout's hash is set by the serializer once the capture is done
+	_keys.push_back(key);
+	_fieldSizes.push_back(size);
+}
+
+void SerializerSchema::Reset()
+{
+	_keys.clear();
+	_fieldSizes.clear();
+	_hash = 0;
+	_ready = false;
+}
+
+Serializer::Serializer(uint32_t version, bool forSave, SerializerSchema* schema, vector<uint8_t>& buffer)
+{
+	_version = version;
+	_saving = forSave;
+	_format = SerializeFormat::Schema;
+	_schema = schema;
+
+	if(forSave) {
+		if(!_schema->IsReady()) {
+			_schema->Reset();
+		}
+		_skipKeys = _schema->IsReady();
+
+		_data.swap(buffer);
+		_data.clear();
+	} else {
+		//Schema-format data can only be loaded with the schema that was used to create it
+		_skipKeys = true;
+		_schemaError = !_schema->IsReady();
+		_schemaData = buffer.data();
+		_schemaDataSize = (uint32_t)buffer.size();
+	}
+}
+
+void Serializer::CaptureSchemaField(const char* name, int index, uint32_t size)
+{
+	string key = GetKey(name, index);
+	CheckDuplicateKey(key);
+	_schema->AddField(key, size);
+}
+
 void Serializer::AddKeyPrefix(string prefix)
 {
 	vector<string> keys;
@@ -73,9 +120,13 @@ bool Serializer::LoadFrom(istream &file)
 
 	char value = 0;
 	file.get(value);
-	bool isCompressed = value == 1;
+
+	//0 = uncompressed, otherwise the value is the codec used to compress the data (+1)
+	bool isCompressed = value != 0;
 
 	if(isCompressed) {
+		CompressionCodec codec = (CompressionCodec)(value - 1);
+
 		uint32_t decompressedSize;
 		file.read((char*)&decompressedSize, sizeof(decompressedSize));
 
@@ -91,9 +142,7 @@ bool Serializer::LoadFrom(istream &file)
 		file.read((char*)compressedData.data(), compressedSize);
 
 		_data = vector<uint8_t>(decompressedSize, 0);
-
-		unsigned long decompSize = decompressedSize;
-		if(uncompress(_data.data(), &decompSize, compressedData.data(), (unsigned long)compressedData.size()) != MZ_OK) {
+		if(!CompressionHelper::DecompressBlock(codec, compressedData.data(), compressedSize, _data.data(), decompressedSize)) {
 			return false;
 		}
 	} else {
@@ -205,30 +254,81 @@ bool Serializer::LoadFromTextFormat(istream& file)
 }
 
 void Serializer::SaveTo(ostream& file, int compressionLevel)
+{
+	SaveTo(file, compressionLevel, CompressionCodec::Deflate);
+}
+
+void Serializer::SaveTo(ostream& file, int compressionLevel, CompressionCodec codec)
 {
 	if(_format == SerializeFormat::Text) {
 		file.write((char*)_data.data(), _data.size());
 	} else {
 		bool isCompressed = compressionLevel > 0;
-		file.put((char)isCompressed);
+		file.put(isCompressed ? (char)codec + 1 : 0);
 
 		if(isCompressed) {
-			unsigned long compressedSize = compressBound((unsigned long)_data.size());
-			uint8_t* compressedData = new uint8_t[compressedSize];
-			compress2(compressedData, &compressedSize, (unsigned char*)_data.data(), (unsigned long)_data.size(), compressionLevel);
+			vector<uint8_t> compressedData;
+			CompressionHelper::CompressBlock(codec, _data.data(), (uint32_t)_data.size(), compressionLevel, compressedData);
 
-			uint32_t size = (uint32_t)compressedSize;
+			uint32_t size = (uint32_t)compressedData.size();
 			uint32_t originalSize = (uint32_t)_data.size();
 			file.write((char*)&originalSize, sizeof(uint32_t));
 			file.write((char*)&size, sizeof(uint32_t));
-			file.write((char*)compressedData, compressedSize);
-			delete[] compressedData;
+			file.write((char*)compressedData.data(), compressedData.size());
 		} else {
 			file.write((char*)_data.data(), _data.size());
 		}
 	}
 }
 
+void Serializer::SaveTo(vector<uint8_t>& buffer)
+{
+	if(_skipKeys && (_schemaFieldIndex != _schema->GetFieldCount() || _layoutHash != _schema->GetHash())) {
+		//Fewer values were written than the schema expects, or the fields are not the same (same sizes, different names)
+		_schemaError = true;
+	}
+
+	if(!_schemaError && !_schema->_ready) {
+		_schema->_hash = _layoutHash;
+		_schema->_ready = true;
+	}
+
+	//Give the buffer back to the caller (no copy), the caller needs to capture a new schema if the data is invalid
+	_data.swap(buffer);
+}
+
+bool Serializer::ConvertSchemaData(SerializerSchema& schema, vector<uint8_t>& schemaData, ostream& out)
+{
+	Serializer s(0, false, &schema, schemaData);
+	if(!s.IsSchemaValid()) {
+		return false;
+	}
+
+	vector<uint8_t> data;
+	data.reserve(s._schemaDataSize * 2);
+	for(size_t i = 0; i < schema._keys.size(); i++) {
+		uint32_t size = schema._fieldSizes[i];
+		if(size == SerializerSchema::VariableSize && !s.ReadSchemaData(&size, sizeof(size))) {
+			return false;
+		}
+
+		if(s._schemaPos + size > s._schemaDataSize) {
+			return false;
+		}
+
+		string& key = schema._keys[i];
+		data.insert(data.end(), key.begin(), key.end());
+		data.push_back(0);
+		data.insert(data.end(), (uint8_t*)&size, (uint8_t*)&size + sizeof(size));
+		data.insert(data.end(), s._schemaData + s._schemaPos, s._schemaData + s._schemaPos + size);
+		s._schemaPos += size;
+	}
+
+	out.put(0);
+	out.write((char*)data.data(), data.size());
+	return true;
+}
+
 void Serializer::LoadFromMap(unordered_map<string, SerializeMapValue>& map)
 {
 	_mapValues = map;
@@ -269,12 +369,27 @@ string Serializer::NormalizeName(const char* name, int index)
 
 void Serializer::PushNamePrefix(const char* name, int index)
 {
+	if(_format == SerializeFormat::Schema) {
+		uint64_t prefixHash = _prefixHashes.empty() ? SerializerSchema::HashSeed : _prefixHashes.back();
+		_prefixHashes.push_back(SerializerSchema::HashName(prefixHash, name, index));
+	}
+
+	if(_skipKeys) {
+		return;
+	}
 	_prefixes.push_back(NormalizeName(name, index));
 	UpdatePrefix();
 }
 
 void Serializer::PopNamePrefix()
 {
+	if(_format == SerializeFormat::Schema) {
+		_prefixHashes.pop_back();
+	}
+
+	if(_skipKeys) {
+		return;
+	}
 	_prefixes.pop_back();
 	UpdatePrefix();
 }
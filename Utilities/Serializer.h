@@ -7,6 +7,7 @@
 #include "Utilities/safe_ptr.h"
 
 class Serializer;
+enum class CompressionCodec : uint8_t;
 
 #define SV(var) (s.Stream(var, #var))
 #define SVArray(arr, count) (s.StreamArray(arr, count, #arr))
@@ -66,7 +67,50 @@ enum class SerializeFormat
 {
 	Binary,
 	Text,
-	Map
+	Map,
+	Schema
+};
+
+class SerializerSchema
+{
+private:
+	friend class Serializer;
+
+	static constexpr uint32_t VariableSize = 0xFFFFFFFF;
+
+	//FNV-1a, used to hash the layout (names, indexes and sizes of the fields, in the order they are serialized)
+	static constexpr uint64_t HashSeed = 0xCBF29CE484222325;
+	static constexpr uint64_t HashPrime = 0x100000001B3;
+
+	vector<string> _keys;
+	vector<uint32_t> _fieldSizes;
+	uint64_t _hash = 0;
+	bool _ready = false;
+
+	void AddField(string& key, uint32_t size);
+
+	__forceinline static uint64_t HashValue(uint64_t hash, uint32_t value)
+	{
+		for(int i = 0; i < 4; i++) {
+			hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * HashPrime;
+		}
+		return hash;
+	}
+
+	__forceinline static uint64_t HashName(uint64_t hash, const char* name, int index)
+	{
+		for(const char* c = name; *c; c++) {
+			hash = (hash ^ (uint8_t)*c) * HashPrime;
+		}
+		return HashValue(hash, (uint32_t)index);
+	}
+
+public:
+	void Reset();
+
+	bool IsReady() { return _ready; }
+	uint64_t GetHash() { return _hash; }
+	uint32_t GetFieldCount() { return (uint32_t)_fieldSizes.size(); }
 };
 
 class Serializer
@@ -86,6 +130,21 @@ private:
 	bool _saving = false;
 	SerializeFormat _format = SerializeFormat::Binary;
 
+	//Schema format: values are written in call order without their keys, and the
+	//key layout is captured once (per console/rom) in the schema instead
+	SerializerSchema* _schema = nullptr;
+	bool _skipKeys = false;
+	bool _schemaError = false;
+	uint32_t _schemaFieldIndex = 0;
+
+	//Hash of the layout streamed so far, compared against the schema's hash - the field sizes alone can't detect
+	//layout changes that keep the same sizes. Hashes the raw names, so the keys don't need to be built.
+	uint64_t _layoutHash = SerializerSchema::HashSeed;
+	vector<uint64_t> _prefixHashes;
+	uint8_t* _schemaData = nullptr;
+	uint32_t _schemaDataSize = 0;
+	uint32_t _schemaPos = 0;
+
 private:
 	bool LoadFromTextFormat(istream& file);
 	string NormalizeName(const char* name, int index);
@@ -212,9 +271,96 @@ private:
 #endif
 	}
 
+	void CaptureSchemaField(const char* name, int index, uint32_t size);
+
+	__forceinline bool CheckSchemaField(const char* name, int index, uint32_t size)
+	{
+		if(_schemaError) {
+			return false;
+		}
+
+		uint64_t prefixHash = _prefixHashes.empty() ? SerializerSchema::HashSeed : _prefixHashes.back();
+		uint64_t fieldHash = SerializerSchema::HashValue(SerializerSchema::HashName(prefixHash, name, index), size);
+		_layoutHash = (_layoutHash ^ fieldHash) * SerializerSchema::HashPrime;
+
+		if(!_skipKeys) {
+			//First save with this schema, build the keys to capture the layout
+			CaptureSchemaField(name, index, size);
+			return true;
+		} else if(_schemaFieldIndex >= _schema->_fieldSizes.size() || _schema->_fieldSizes[_schemaFieldIndex] != size) {
+			//Layout no longer matches the schema (e.g controllers were changed), the data is unusable
+			_schemaError = true;
+			return false;
+		}
+		_schemaFieldIndex++;
+		return true;
+	}
+
+	__forceinline void WriteSchemaData(void* src, uint32_t size)
+	{
+		uint8_t* ptr = (uint8_t*)src;
+		_data.insert(_data.end(), ptr, ptr + size);
+	}
+
+	__forceinline bool ReadSchemaData(void* dst, uint32_t size)
+	{
+		if(_schemaPos + size > _schemaDataSize) {
+			_schemaError = true;
+			return false;
+		}
+		memcpy(dst, _schemaData + _schemaPos, size);
+		_schemaPos += size;
+		return true;
+	}
+
+	template<typename T>
+	void StreamSchemaValue(T& value, const char* name, int index)
+	{
+		if(CheckSchemaField(name, index, sizeof(T))) {
+			if(_saving) {
+				WriteSchemaData(&value, sizeof(T));
+			} else {
+				ReadSchemaData(&value, sizeof(T));
+			}
+		}
+	}
+
+	template<typename T>
+	void StreamSchemaVector(T& values, const char* name, int index)
+	{
+		if(!CheckSchemaField(name, index, SerializerSchema::VariableSize)) {
+			return;
+		}
+
+		constexpr uint32_t elementSize = (uint32_t)sizeof(typename T::value_type);
+		if(_saving) {
+			uint32_t size = (uint32_t)values.size() * elementSize;
+			WriteSchemaData(&size, sizeof(size));
+			WriteSchemaData(values.data(), size);
+		} else {
+			uint32_t size = 0;
+			if(ReadSchemaData(&size, sizeof(size))) {
+				if(_schemaPos + size > _schemaDataSize) {
+					_schemaError = true;
+					return;
+				}
+				values.resize(size / elementSize);
+				ReadSchemaData(values.data(), (uint32_t)values.size() * elementSize);
+			}
+		}
+	}
+
 public:
 	Serializer(uint32_t version, bool forSave, SerializeFormat format = SerializeFormat::Binary);
 
+	//Schema format (in-memory states) - saving writes directly into the buffer (its capacity is reused) and
+	//captures the schema on the first save, loading reads the buffer's values in the order defined by the schema
+	Serializer(uint32_t version, bool forSave, SerializerSchema* schema, vector<uint8_t>& buffer);
+	bool IsSchemaValid() { return !_schemaError; }
+
+	//True when everything streamed matched the schema's layout (same fields, in the same order)
+	bool IsLayoutValid() { return !_schemaError && _schemaFieldIndex == _schema->GetFieldCount() && _layoutHash == _schema->GetHash(); }
+
 	uint32_t GetVersion() { return _version; }
 	bool IsSaving() { return _saving; }
 	
@@ -241,6 +387,8 @@ public:
 		
 		if constexpr(std::is_base_of<ISerializable, T>::value) {
 			Stream((ISerializable&)value, name, index);
+		} else if(_format == SerializeFormat::Schema) {
+			StreamSchemaValue(value, name, index);
 		} else {
 			string key = GetKey(name, index);
 
@@ -262,6 +410,7 @@ public:
 
 					case SerializeFormat::Text: WriteTextFormat(key, value); break;
 					case SerializeFormat::Map: WriteMapFormat(key, value); break;
+					case SerializeFormat::Schema: break; //Handled above
 				}
 			} else {
 				switch(_format) {
@@ -295,6 +444,8 @@ public:
 					case SerializeFormat::Map:
 						ReadMapFormat(key, value);
 						break;
+
+					case SerializeFormat::Schema: break; //Handled above
 				}
 			}
 		}
@@ -343,6 +494,16 @@ public:
 	{
 		if(_format == SerializeFormat::Map) {
 			return;
+		} else if(_format == SerializeFormat::Schema) {
+			uint32_t size = elementCount * sizeof(T);
+			if(CheckSchemaField(name, -1, size)) {
+				if(_saving) {
+					WriteSchemaData(arrayValues, size);
+				} else {
+					ReadSchemaData(arrayValues, size);
+				}
+			}
+			return;
 		}
 
 		string key = GetKey(name, -1);
@@ -392,6 +553,9 @@ public:
 	{
 		if(_format == SerializeFormat::Map) {
 			return;
+		} else if(_format == SerializeFormat::Schema) {
+			StreamSchemaVector(values, name, index);
+			return;
 		}
 
 		string key = GetKey(name, index);
@@ -432,12 +596,22 @@ public:
 	void PushNamePrefix(const char* name, int index = -1);
 	void PopNamePrefix();
 	void SaveTo(ostream &file, int compressionLevel = 1);
+	void SaveTo(ostream &file, int compressionLevel, CompressionCodec codec);
+	void SaveTo(vector<uint8_t>& buffer);
 	bool LoadFrom(istream& file);
 	void LoadFromMap(unordered_map<string, SerializeMapValue>& map);
+
+	//Converts schema-format data back to the keyed binary format (e.g to save it to the disk)
+	static bool ConvertSchemaData(SerializerSchema& schema, vector<uint8_t>& data, ostream& out);
 };
 
 template<> inline void Serializer::Stream(string& value, const char* name, int index)
 {
+	if(_format == SerializeFormat::Schema) {
+		StreamSchemaVector(value, name, index);
+		return;
+	}
+
 	string key = GetKey(name, index);
 
 	CheckDuplicateKey(key);
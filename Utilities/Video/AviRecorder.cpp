@@ -1,16 +1,13 @@
 #include "pch.h"
 #include "AviRecorder.h"
 
-AviRecorder::AviRecorder(VideoCodec codec, uint32_t compressionLevel)
+AviRecorder::AviRecorder(VideoCodec codec, uint32_t compressionLevel, RecordFramePolicy framePolicy)
 {
 	_recording = false;
-	_stopFlag = false;
-	_framePending = false;
-	_frameBuffer = nullptr;
-	_frameBufferLength = 0;
 	_sampleRate = 0;
 	_codec = codec;
 	_compressionLevel = compressionLevel;
+	_framePolicy = framePolicy;
 }
 
 AviRecorder::~AviRecorder()
@@ -18,11 +15,6 @@ AviRecorder::~AviRecorder()
 	if(_recording) {
 		StopRecording();
 	}
-
-	if(_frameBuffer) {
-		delete[] _frameBuffer;
-		_frameBuffer = nullptr;
-	}
 }
 
 bool AviRecorder::Init(string filename)
@@ -44,8 +36,6 @@ bool AviRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 		_width = width;
 		_height = height;
 		_fps = fps;
-		_frameBufferLength = height * width * bpp;
-		_frameBuffer = new uint8_t[_frameBufferLength];
 
 		_aviWriter.reset(new AviWriter());
 		if(!_aviWriter->StartWrite(_outputFile, _codec, width, height, bpp, (uint32_t)(_fps * 1000000), audioSampleRate, _compressionLevel)) {
@@ -53,18 +43,15 @@ bool AviRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 			return false;
 		}
 
-		_aviWriterThread = std::thread([=]() {
-			while(!_stopFlag) {
-				_waitFrame.Wait();
-				if(_stopFlag) {
-					break;
-				}
-
-				auto lock = _lock.AcquireSafe();
-				_aviWriter->AddFrame(_frameBuffer);
-				_framePending = false;
+		//Frames are compressed and written on the queue's thread
+		_frameQueue.reset(new FrameQueue(height * width * bpp, _framePolicy, [this](uint8_t* frame) {
+			if(frame) {
+				_aviWriter->AddFrame(frame);
+			} else {
+				//Dropped frame, repeat the previous one to keep the video in sync with the audio
+				_aviWriter->AddDroppedFrame();
 			}
-		});
+		}));
 
 		_recording = true;
 	}
@@ -76,9 +63,9 @@ void AviRecorder::StopRecording()
 	if(_recording) {
 		_recording = false;
 
-		_stopFlag = true;
-		_waitFrame.Signal();
-		_aviWriterThread.join();
+		_frameQueue->Stop();
+		_stats = _frameQueue->GetStats();
+		_frameQueue.reset();
 
 		_aviWriter->EndWrite();
 		_aviWriter.reset();
@@ -91,15 +78,7 @@ bool AviRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 		if(_width != width || _height != height || _fps != fps) {
 			return false;
 		} else {
-			while(_framePending) {
-				//Previous frame isn't done processing yet, wait
-				std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
-			}
-
-			auto lock = _lock.AcquireSafe();
-			_framePending = true;
-			memcpy(_frameBuffer, frameBuffer, _frameBufferLength);
-			_waitFrame.Signal();
+			_frameQueue->Push(frameBuffer);
 		}
 	}
 	return true;
@@ -125,4 +104,9 @@ bool AviRecorder::IsRecording()
 string AviRecorder::GetOutputFile()
 {
 	return _outputFile;
+}
+
+RecordingStats AviRecorder::GetStats()
+{
+	return _frameQueue ? _frameQueue->GetStats() : _stats;
 }
\ No newline at end of file
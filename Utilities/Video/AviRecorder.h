@@ -1,28 +1,19 @@
 #pragma once
 #include "pch.h"
-#include <thread>
-#include "Utilities/AutoResetEvent.h"
-#include "Utilities/SimpleLock.h"
 #include "Utilities/Video/AviWriter.h"
+#include "Utilities/Video/FrameQueue.h"
 #include "Utilities/Video/IVideoRecorder.h"
 
 class AviRecorder final : public IVideoRecorder
 {
 private:
-	std::thread _aviWriterThread;
-	
 	unique_ptr<AviWriter> _aviWriter;
+	unique_ptr<FrameQueue> _frameQueue;
+	RecordingStats _stats = {};
 
 	string _outputFile;
-	SimpleLock _lock;
-	AutoResetEvent _waitFrame;
-
-	atomic<bool> _stopFlag;
-	atomic<bool> _framePending;
 
 	bool _recording;
-	uint8_t* _frameBuffer;
-	uint32_t _frameBufferLength;
 	uint32_t _sampleRate;
 
 	double _fps;
@@ -31,9 +22,10 @@ private:
 
 	VideoCodec _codec;
 	uint32_t _compressionLevel;
+	RecordFramePolicy _framePolicy;
 
 public:
-	AviRecorder(VideoCodec codec, uint32_t compressionLevel);
+	AviRecorder(VideoCodec codec, uint32_t compressionLevel, RecordFramePolicy framePolicy);
 	virtual ~AviRecorder();
 
 	bool Init(string filename) override;
@@ -45,4 +37,5 @@ public:
 
 	bool IsRecording() override;
 	string GetOutputFile() override;
+	RecordingStats GetStats() override;
 };
\ No newline at end of file
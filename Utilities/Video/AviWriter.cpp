@@ -99,6 +99,8 @@ bool AviWriter::StartWrite(string filename, VideoCodec codec, uint32_t width, ui
 		_file.put(0);
 	}
 	_frames = 0;
+	_hasPendingFrame = false;
+	_pendingDroppedFrames = 0;
 	_written = 0;
 	_audioPos = 0;
 	_audiowritten = 0;
@@ -108,6 +110,16 @@ bool AviWriter::StartWrite(string filename, VideoCodec codec, uint32_t width, ui
 
 void AviWriter::EndWrite()
 {
+	if(_hasPendingFrame) {
+		uint8_t* compressedData = nullptr;
+		int written = _codec->FlushFrame(&compressedData);
+		if(written >= 0) {
+			WriteVideoChunk(compressedData, written, _pendingKeyFrame);
+		}
+		_hasPendingFrame = false;
+	}
+	WriteDroppedFrames();
+
 	/* Close the video */
 	uint8_t avi_header[AviWriter::AviHeaderSize];
 	uint32_t main_list;
@@ -239,7 +251,9 @@ void AviWriter::AddFrame(uint8_t *frameData)
 		return;
 	}
 
-	bool isKeyFrame = (_frames % 120 == 0) ? 1 : 0;
+	//A pipelined codec is one frame behind, so the pending frame hasn't been counted yet
+	uint32_t frameIndex = _frames + (_hasPendingFrame ? 1 : 0);
+	bool isKeyFrame = (frameIndex % 120 == 0) ? 1 : 0;
 
 	uint8_t* compressedData = nullptr;
 	int written = _codec->CompressFrame(isKeyFrame, frameData, &compressedData);
@@ -247,7 +261,46 @@ void AviWriter::AddFrame(uint8_t *frameData)
 		return;
 	}
 
-	if(_codecType == VideoCodec::None) {
+	if(_codec->IsPipelined()) {
+		//The data returned is for the previous frame
+		std::swap(isKeyFrame, _pendingKeyFrame);
+		bool hadPendingFrame = _hasPendingFrame;
+		_hasPendingFrame = true;
+		if(!hadPendingFrame) {
+			return;
+		}
+	}
+
+	WriteVideoChunk(compressedData, written, isKeyFrame);
+
+	//Frames dropped after the frame that was just written
+	WriteDroppedFrames();
+}
+
+void AviWriter::AddDroppedFrame()
+{
+	if(!_file) {
+		return;
+	}
+
+	_pendingDroppedFrames++;
+	if(!_hasPendingFrame) {
+		//The previous frame has already been written, the repeat can be written right away
+		WriteDroppedFrames();
+	}
+}
+
+void AviWriter::WriteDroppedFrames()
+{
+	//An empty video chunk repeats the previous frame
+	for(; _pendingDroppedFrames > 0; _pendingDroppedFrames--) {
+		WriteVideoChunk(nullptr, 0, false);
+	}
+}
+
+void AviWriter::WriteVideoChunk(uint8_t* compressedData, int written, bool isKeyFrame)
+{
+	if(_codecType == VideoCodec::None && written > 0) {
 		isKeyFrame = true;
 	}
 	WriteAviChunk(_codecType == VideoCodec::None ? "00db" : "00dc", written, compressedData, isKeyFrame ? 0x10 : 0);
@@ -255,7 +308,7 @@ void AviWriter::AddFrame(uint8_t *frameData)
 
 	if(_audioPos) {
 		auto lock = _audioLock.AcquireSafe();
-		WriteAviChunk("01wb", _audioPos, _audiobuf, 0);
+		WriteAviChunk("01wb", _audioPos, _audiobuf.data(), 0);
 		_audiowritten += _audioPos;
 		_audioPos = 0;
 	}
@@ -268,6 +321,10 @@ void AviWriter::AddSound(int16_t *data, uint32_t sampleCount)
 	}
 
 	auto lock = _audioLock.AcquireSafe();
-	memcpy(_audiobuf+_audioPos/2, data, sampleCount * 4);
+	//Frames are encoded on another thread, so more than a frame's worth of audio can be buffered here
+	if(_audiobuf.size() < _audioPos / 2 + sampleCount * 2) {
+		_audiobuf.resize(std::max<size_t>(_audioPos / 2 + sampleCount * 2, WaveBufferSize));
+	}
+	memcpy(_audiobuf.data() + _audioPos / 2, data, sampleCount * 4);
 	_audioPos += sampleCount * 4;
 }
\ No newline at end of file
@@ -25,12 +25,15 @@ private:
 
 	VideoCodec _codecType;
 
-	int16_t _audiobuf[WaveBufferSize];
+	vector<int16_t> _audiobuf;
 	uint32_t _audioPos = 0;
 	uint32_t _audiorate = 0;
 	uint32_t _audiowritten = 0;
 
 	uint32_t _frames = 0;
+	bool _hasPendingFrame = false;
+	bool _pendingKeyFrame = false;
+	uint32_t _pendingDroppedFrames = 0;
 	uint32_t _width = 0;
 	uint32_t _height = 0;
 	uint32_t _bpp = 0;
@@ -47,9 +50,12 @@ private:
 	void host_writew(uint8_t* buffer, uint16_t value);
 	void host_writed(uint8_t* buffer, uint32_t value);
 	void WriteAviChunk(const char * tag, uint32_t size, void * data, uint32_t flags);
+	void WriteVideoChunk(uint8_t* compressedData, int written, bool isKeyFrame);
+	void WriteDroppedFrames();
 
 public:
 	void AddFrame(uint8_t* frameData);
+	void AddDroppedFrame();
 	void AddSound(int16_t * data, uint32_t sampleCount);
 
 	bool StartWrite(string filename, VideoCodec codec, uint32_t width, uint32_t height, uint32_t bpp, uint32_t fps, uint32_t audioSampleRate, uint32_t compressionLevel);
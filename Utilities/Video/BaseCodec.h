@@ -8,5 +8,10 @@ public:
 	virtual int CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t** compressedData) = 0;
 	virtual const char* GetFourCC() = 0;
 
+	//Pipelined codecs compress a frame while the next one is being prepared: CompressFrame returns the
+	//previous frame's data (0 bytes for the first frame), and FlushFrame returns the last frame's data
+	virtual bool IsPipelined() { return false; }
+	virtual int FlushFrame(uint8_t** compressedData) { return 0; }
+
 	virtual ~BaseCodec() { }
 };
\ No newline at end of file
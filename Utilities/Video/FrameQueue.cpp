@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "Utilities/Video/FrameQueue.h"
+
+FrameQueue::FrameQueue(uint32_t frameSize, RecordFramePolicy policy, std::function<void(uint8_t*)> processFrame)
+{
+	_frameSize = frameSize;
+	_policy = policy;
+	_processFrame = processFrame;
+	_maxQueuedFrames = policy == RecordFramePolicy::Grow ? MaxFrameCount : DefaultFrameCount;
+
+	_writePos = 0;
+	_readPos = 0;
+	_stopFlag = false;
+	_frameCount = 0;
+	_droppedFrames = 0;
+	_lateFrames = 0;
+
+	_encoderThread = std::thread(&FrameQueue::EncoderThread, this);
+}
+
+FrameQueue::~FrameQueue()
+{
+	Stop();
+}
+
+void FrameQueue::EncoderThread()
+{
+	while(true) {
+		uint32_t readPos = _readPos;
+		if(readPos == _writePos) {
+			if(_stopFlag) {
+				break;
+			}
+			_frameAdded.Wait();
+			continue;
+		}
+
+		uint32_t slot = readPos % _maxQueuedFrames;
+		for(uint32_t i = 0; i < _droppedBefore[slot]; i++) {
+			_processFrame(nullptr);
+		}
+		_processFrame(_frames[slot].get());
+		_readPos = readPos + 1;
+		_frameRemoved.Signal();
+	}
+}
+
+bool FrameQueue::Push(void* frameBuffer)
+{
+	_frameCount++;
+
+	uint32_t writePos = _writePos;
+	if(writePos - _readPos >= _maxQueuedFrames) {
+		if(_policy == RecordFramePolicy::Drop) {
+			_droppedFrames++;
+			_pendingDrops++;
+			return false;
+		}
+
+		//The encoder is behind, wait for it to process a frame
+		_lateFrames++;
+		while(writePos - _readPos >= _maxQueuedFrames) {
+			_frameRemoved.Wait();
+		}
+	}
+
+	uint32_t slot = writePos % _maxQueuedFrames;
+	unique_ptr<uint8_t[]>& frame = _frames[slot];
+	if(!frame) {
+		frame.reset(new uint8_t[_frameSize]);
+	}
+	memcpy(frame.get(), frameBuffer, _frameSize);
+	_droppedBefore[slot] = _pendingDrops;
+	_pendingDrops = 0;
+
+	_writePos = writePos + 1;
+	_frameAdded.Signal();
+	return true;
+}
+
+void FrameQueue::Stop()
+{
+	if(_encoderThread.joinable()) {
+		_stopFlag = true;
+		_frameAdded.Signal();
+		_encoderThread.join();
+
+		//Frames dropped after the last queued frame
+		for(; _pendingDrops > 0; _pendingDrops--) {
+			_processFrame(nullptr);
+		}
+	}
+}
+
+RecordingStats FrameQueue::GetStats()
+{
+	return { _frameCount, _droppedFrames, _lateFrames };
+}
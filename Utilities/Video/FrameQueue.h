@@ -0,0 +1,68 @@
+#pragma once
+#include "pch.h"
+#include <thread>
+#include <functional>
+#include "Utilities/AutoResetEvent.h"
+
+//What to do when the encoder thread can't keep up with the emulation
+enum class RecordFramePolicy
+{
+	Block = 0, //Wait until the encoder has processed a frame
+	Drop = 1, //Skip the new frame (the encoder is told about it, in order, so it can keep the video in sync with the audio)
+	Grow = 2 //Queue more frames (up to MaxFrameCount), and wait when that is not enough
+};
+
+struct RecordingStats
+{
+	uint32_t FrameCount;
+	uint32_t DroppedFrames;
+	uint32_t LateFrames;
+};
+
+//Bounded ring of frame buffers between the thread that produces the frames and an encoder thread
+//Only one thread can call Push, the frames are processed in order on the queue's own thread
+//Dropped frames are processed as a null frame, at the position they would have had in the stream
+class FrameQueue
+{
+private:
+	static constexpr uint32_t DefaultFrameCount = 4;
+	static constexpr uint32_t MaxFrameCount = 120;
+
+	std::thread _encoderThread;
+	std::function<void(uint8_t*)> _processFrame;
+
+	//Ring of _maxQueuedFrames slots - buffers are allocated on first use, so only the grow policy goes beyond DefaultFrameCount buffers
+	unique_ptr<uint8_t[]> _frames[MaxFrameCount];
+	//Number of frames dropped right before the frame in the matching slot
+	uint32_t _droppedBefore[MaxFrameCount] = {};
+	//Frames dropped since the last queued frame (only used by Push, and by Stop once the encoder thread is done)
+	uint32_t _pendingDrops = 0;
+	uint32_t _frameSize = 0;
+	uint32_t _maxQueuedFrames = 0;
+	RecordFramePolicy _policy = RecordFramePolicy::Block;
+
+	//Each position is only written by a single thread (_writePos by Push, _readPos by the encoder thread)
+	atomic<uint32_t> _writePos;
+	atomic<uint32_t> _readPos;
+	AutoResetEvent _frameAdded;
+	AutoResetEvent _frameRemoved;
+	atomic<bool> _stopFlag;
+
+	atomic<uint32_t> _frameCount;
+	atomic<uint32_t> _droppedFrames;
+	atomic<uint32_t> _lateFrames;
+
+	void EncoderThread();
+
+public:
+	FrameQueue(uint32_t frameSize, RecordFramePolicy policy, std::function<void(uint8_t*)> processFrame);
+	~FrameQueue();
+
+	//Copies the frame into the queue, returns false when the frame was dropped
+	bool Push(void* frameBuffer);
+
+	//Processes all queued (and trailing dropped) frames and stops the encoder thread
+	void Stop();
+
+	RecordingStats GetStats();
+};
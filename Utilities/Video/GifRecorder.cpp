@@ -2,9 +2,10 @@
 #include "GifRecorder.h"
 #include "gif.h"
 
-GifRecorder::GifRecorder()
+GifRecorder::GifRecorder(RecordFramePolicy framePolicy)
 {
 	_gif.reset(new GifWriter());
+	_framePolicy = framePolicy;
 	_frameCounter = 0;
 }
 
@@ -31,19 +32,35 @@ bool GifRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 
 	_recording = GifBegin(_gif.get(), _outputFile.c_str(), width, height, 2, 8, false);
 	_frameCounter = 0;
+
+	if(_recording) {
+		//Frames are quantized and written on the queue's thread
+		_frameQueue.reset(new FrameQueue(width * height * 4, _framePolicy, [this](uint8_t* frame) {
+			//Dropped frames are skipped (GIFs have no audio to stay in sync with)
+			if(frame) {
+				GifWriteFrame(_gif.get(), frame, _width, _height, 2, 8, false);
+			}
+		}));
+	}
 	return _recording;
 }
 
 void GifRecorder::StopRecording()
 {
 	if(_recording) {
+		_recording = false;
+
+		_frameQueue->Stop();
+		_stats = _frameQueue->GetStats();
+		_frameQueue.reset();
+
 		GifEnd(_gif.get());
 	}
 }
 
 bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps)
 {
-	if(_width != width || _height != height || _fps != fps) {
+	if(!_recording || _width != width || _height != height || _fps != fps) {
 		return false;
 	}
 
@@ -51,7 +68,7 @@ bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 	
 	if(fps < 55 || (_frameCounter % 6) != 0) {
 		//At 60 FPS, skip 1 of every 6 frames (max FPS for GIFs is 50fps)
-		GifWriteFrame(_gif.get(), (uint8_t*)frameBuffer, width, height, 2, 8, false);
+		_frameQueue->Push(frameBuffer);
 	}
 
 	return true;
@@ -70,4 +87,9 @@ bool GifRecorder::IsRecording()
 string GifRecorder::GetOutputFile()
 {
 	return _outputFile;
+}
+
+RecordingStats GifRecorder::GetStats()
+{
+	return _frameQueue ? _frameQueue->GetStats() : _stats;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include "Utilities/Video/IVideoRecorder.h"
+#include "Utilities/Video/FrameQueue.h"
 
 struct GifWriter;
 
@@ -8,6 +9,9 @@ class GifRecorder final : public IVideoRecorder
 {
 private:
 	std::unique_ptr<GifWriter> _gif;
+	unique_ptr<FrameQueue> _frameQueue;
+	RecordFramePolicy _framePolicy = RecordFramePolicy::Block;
+	RecordingStats _stats = {};
 	bool _recording = false;
 	uint32_t _frameCounter = 0;
 	string _outputFile;
@@ -16,7 +20,7 @@ private:
 	double _fps = 0;
 
 public:
-	GifRecorder();
+	GifRecorder(RecordFramePolicy framePolicy);
 	virtual ~GifRecorder();
 
 	bool Init(string filename) override;
@@ -26,4 +30,5 @@ public:
 	bool AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate) override;
 	bool IsRecording() override;
 	string GetOutputFile() override;
+	RecordingStats GetStats() override;
 };
\ No newline at end of file
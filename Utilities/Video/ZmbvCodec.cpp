@@ -78,11 +78,12 @@ bool ZmbvCodec::SetupBuffers(zmbv_format_t _format, int blockwidth, int blockhei
 	buf1 = new unsigned char[bufsize];
 	buf2 = new unsigned char[bufsize];
 	work = new unsigned char[bufsize];
+	_deflateWork = new unsigned char[bufsize];
 
-	int xblocks = (width/blockwidth);
+	xblocks = (width/blockwidth);
 	int xleft = width % blockwidth;
 	if (xleft) xblocks++;
-	int yblocks = (height/blockheight);
+	yblocks = (height/blockheight);
 	int yleft = height % blockheight;
 	if (yleft) yblocks++;
 	blockcount=yblocks*xblocks;
@@ -115,12 +116,14 @@ bool ZmbvCodec::SetupBuffers(zmbv_format_t _format, int blockwidth, int blockhei
 	memset(buf1,0,bufsize);
 	memset(buf2,0,bufsize);
 	memset(work,0,bufsize);
+	memset(_deflateWork,0,bufsize);
 	oldframe=buf1;
 	newframe=buf2;
 	format = _format;
 
 	_bufSize = NeededSize(width, height, format);
 	_buf = new uint8_t[_bufSize];
+	_deflateBuf = new uint8_t[_bufSize];
 
 	return true;
 }
@@ -174,51 +177,77 @@ INLINE int ZmbvCodec::CompareBlock(int vx,int vy,FrameBlock * block) {
 }
 
 template<class P>
-INLINE void ZmbvCodec::AddXorBlock(int vx,int vy,FrameBlock * block) {
+INLINE void ZmbvCodec::AddXorBlock(int vx,int vy,FrameBlock * block,unsigned char * out) {
 	P * pold=((P*)oldframe)+block->start+(vy*pitch)+vx;
 	P * pnew=((P*)newframe)+block->start;
 	for (int y=0;y<block->dy;y++) {
 		for (int x=0;x<block->dx;x++) {
-			*((P*)&work[workUsed])=pnew[x] ^ pold[x];
-			workUsed+=sizeof(P);
+			*((P*)out)=pnew[x] ^ pold[x];
+			out+=sizeof(P);
 		}
 		pold+=pitch;
 		pnew+=pitch;
 	}
 }
 
+template<class P>
+void ZmbvCodec::FindBestVector(FrameBlock * block) {
+	int bestvx = 0;
+	int bestvy = 0;
+	int bestchange=CompareBlock<P>(0,0, block);
+	int possibles=64;
+	for (int v=0;v<VectorCount && possibles;v++) {
+		if (bestchange<4) break;
+		int vx = VectorTable[v].x;
+		int vy = VectorTable[v].y;
+		if (PossibleBlock<P>(vx, vy, block) < 4) {
+			possibles--;
+			int testchange=CompareBlock<P>(vx,vy, block);
+			if (testchange<bestchange) {
+				bestchange=testchange;
+				bestvx = vx;
+				bestvy = vy;
+			}
+		}
+	}
+	block->bestvx = bestvx;
+	block->bestvy = bestvy;
+	block->bestchange = bestchange;
+}
+
 template<class P>
 void ZmbvCodec::AddXorFrame(void) {
 	signed char * vectors=(signed char*)&work[workUsed];
 	/* Align the following xor data on 4 byte boundary*/
 	workUsed=(workUsed + blockcount*2 +3) & ~3;
+
+	//Each block's search only depends on the old and new frames, so each row of blocks can be searched on a separate thread
+	_workerPool->Run(yblocks, [this](uint32_t row) {
+		for (int b=row*xblocks;b<(int)(row+1)*xblocks;b++) {
+			FindBestVector<P>(&blocks[b]);
+		}
+	});
+
+	//The vectors and the position of each block's xor data depend on the previous blocks
 	for (int b=0;b<blockcount;b++) {
 		FrameBlock * block=&blocks[b];
-		int bestvx = 0;
-		int bestvy = 0;
-		int bestchange=CompareBlock<P>(0,0, block);
-		int possibles=64;
-		for (int v=0;v<VectorCount && possibles;v++) {
-			if (bestchange<4) break;
-			int vx = VectorTable[v].x;
-			int vy = VectorTable[v].y;
-			if (PossibleBlock<P>(vx, vy, block) < 4) {
-				possibles--;
-				int testchange=CompareBlock<P>(vx,vy, block);
-				if (testchange<bestchange) {
-					bestchange=testchange;
-					bestvx = vx;
-					bestvy = vy;
-				}
-			}
-		}
-		vectors[b*2+0]=(bestvx << 1);
-		vectors[b*2+1]=(bestvy << 1);
-		if (bestchange) {
+		vectors[b*2+0]=(block->bestvx << 1);
+		vectors[b*2+1]=(block->bestvy << 1);
+		if (block->bestchange) {
 			vectors[b*2+0]|=1;
-			AddXorBlock<P>(bestvx, bestvy, block);
+			block->xorOffset = workUsed;
+			workUsed += block->dx*block->dy*sizeof(P);
 		}
 	}
+
+	_workerPool->Run(yblocks, [this](uint32_t row) {
+		for (int b=row*xblocks;b<(int)(row+1)*xblocks;b++) {
+			FrameBlock * block=&blocks[b];
+			if (block->bestchange) {
+				AddXorBlock<P>(block->bestvx, block->bestvy, block, &work[block->xorOffset]);
+			}
+		}
+	});
 }
 
 bool ZmbvCodec::SetupCompress( int _width, int _height, uint32_t compressionLevel ) {
@@ -280,8 +309,7 @@ bool ZmbvCodec::PrepareCompressFrame(int flags, zmbv_format_t _format, char * pa
 				work[workUsed++] = palette[i*4+2];
 			}
 		}
-		/* Restart deflate */
-		deflateReset(&zstream);
+		/* Deflate is restarted by the deflate thread when it reaches this frame */
 	} else {
 		if (palsize && pal && memcmp(pal, palette, palsize * 4)) {
 			*firstByte |= Mask_DeltaPalette;
@@ -338,20 +366,59 @@ int ZmbvCodec::FinishCompressFrame(uint8_t** compressedData)
 				break;
 		}
 	}
-	/* Create the actual frame with compression */
-	zstream.next_in = (Bytef *)work;
-	zstream.avail_in = workUsed;
-	zstream.total_in = 0;
+	//Get the previous frame's data, and start compressing this frame on the deflate thread
+	int written = WaitForDeflate(compressedData);
+
+	_deflateReset = (firstByte & Mask_KeyFrame) != 0;
+	_deflateWorkUsed = workUsed;
+	_deflateHeaderSize = compressInfo.writeDone;
+	std::swap(work, _deflateWork);
+	std::swap(_buf, _deflateBuf);
+	_deflatePending = true;
+	_deflateStart.Signal();
+
+	return written;
+}
+
+void ZmbvCodec::DeflateThread()
+{
+	while(true) {
+		_deflateStart.Wait();
+		if(_stopFlag) {
+			break;
+		}
 
-	zstream.next_out = (Bytef *)(compressInfo.writeBuf + compressInfo.writeDone);
-	zstream.avail_out = compressInfo.writeSize - compressInfo.writeDone;
-	zstream.total_out = 0;
-	
-	deflate(&zstream, Z_SYNC_FLUSH);
+		if(_deflateReset) {
+			deflateReset(&zstream);
+		}
+
+		/* Create the actual frame with compression */
+		zstream.next_in = (Bytef *)_deflateWork;
+		zstream.avail_in = _deflateWorkUsed;
+		zstream.total_in = 0;
+
+		zstream.next_out = (Bytef *)(_deflateBuf + _deflateHeaderSize);
+		zstream.avail_out = _bufSize - _deflateHeaderSize;
+		zstream.total_out = 0;
 
-	*compressedData = _buf;
+		deflate(&zstream, Z_SYNC_FLUSH);
+
+		_deflateWritten = _deflateHeaderSize + zstream.total_out;
+		_deflateDone.Signal();
+	}
+}
+
+int ZmbvCodec::WaitForDeflate(uint8_t** compressedData)
+{
+	if(!_deflatePending) {
+		*compressedData = nullptr;
+		return 0;
+	}
 
-	return compressInfo.writeDone + zstream.total_out;
+	_deflateDone.Wait();
+	_deflatePending = false;
+	*compressedData = _deflateBuf;
+	return _deflateWritten;
 }
 
 void ZmbvCodec::FreeBuffers()
@@ -364,8 +431,12 @@ void ZmbvCodec::FreeBuffers()
 	buf2 = nullptr;
 	delete[] work;
 	work = nullptr;
+	delete[] _deflateWork;
+	_deflateWork = nullptr;
 	delete[] _buf;
 	_buf = nullptr;
+	delete[] _deflateBuf;
+	_deflateBuf = nullptr;
 }
 
 ZmbvCodec::ZmbvCodec() 
@@ -376,6 +447,20 @@ ZmbvCodec::ZmbvCodec()
 	buf2 = nullptr;
 	work = nullptr;
 	memset( &zstream, 0, sizeof(zstream));
+
+	_workerPool.reset(new WorkerPool(WorkerPool::GetDefaultThreadCount()));
+	_stopFlag = false;
+	_deflateThread = std::thread(&ZmbvCodec::DeflateThread, this);
+}
+
+ZmbvCodec::~ZmbvCodec()
+{
+	_stopFlag = true;
+	_deflateStart.Signal();
+	_deflateThread.join();
+
+	FreeBuffers();
+	deflateEnd(&zstream);
 }
 
 int ZmbvCodec::CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t** compressedData)
@@ -392,6 +477,11 @@ int ZmbvCodec::CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t** comp
 	return FinishCompressFrame(compressedData);
 }
 
+int ZmbvCodec::FlushFrame(uint8_t** compressedData)
+{
+	return WaitForDeflate(compressedData);
+}
+
 const char* ZmbvCodec::GetFourCC()
 {
 	return "ZMBV";
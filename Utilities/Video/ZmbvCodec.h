@@ -21,8 +21,11 @@
 
 #pragma once
 
+#include <thread>
 #include "BaseCodec.h"
 #include "miniz.h"
+#include "Utilities/AutoResetEvent.h"
+#include "Utilities/WorkerPool.h"
 
 #ifdef _MSC_VER
 #define INLINE __forceinline
@@ -48,6 +51,11 @@ private:
 	struct FrameBlock {
 		int start = 0;
 		int dx = 0,dy = 0;
+
+		//Result of the motion vector search
+		int bestvx = 0,bestvy = 0;
+		int bestchange = 0;
+		int xorOffset = 0;
 	};
 	struct CodecVector {
 		int x = 0,y = 0;
@@ -76,6 +84,7 @@ private:
 	int bufsize = 0;
 
 	int blockcount = 0; 
+	int xblocks = 0, yblocks = 0;
 	FrameBlock * blocks = nullptr;
 
 	int workUsed = 0, workPos = 0;
@@ -91,15 +100,31 @@ private:
 
 	z_stream zstream = {};
 
+	unique_ptr<WorkerPool> _workerPool;
+
+	//Deflate runs on its own thread, one frame behind the motion vector search
+	std::thread _deflateThread;
+	AutoResetEvent _deflateStart;
+	AutoResetEvent _deflateDone;
+	atomic<bool> _stopFlag;
+	bool _deflatePending = false;
+	bool _deflateReset = false;
+	unsigned char* _deflateWork = nullptr;
+	int _deflateWorkUsed = 0;
+	uint8_t* _deflateBuf = nullptr;
+	int _deflateHeaderSize = 0;
+	int _deflateWritten = 0;
+
 	// methods
 	void FreeBuffers(void);
 	void CreateVectorTable(void);
 	bool SetupBuffers(zmbv_format_t format, int blockwidth, int blockheight);
 
 	template<class P> void AddXorFrame(void);
+	template<class P> void FindBestVector(FrameBlock * block);
 	template<class P> INLINE int PossibleBlock(int vx,int vy,FrameBlock * block);
 	template<class P> INLINE int CompareBlock(int vx,int vy,FrameBlock * block);
-	template<class P> INLINE void AddXorBlock(int vx,int vy,FrameBlock * block);
+	template<class P> INLINE void AddXorBlock(int vx,int vy,FrameBlock * block,unsigned char * out);
 
 	int NeededSize(int _width, int _height, zmbv_format_t _format);
 
@@ -107,9 +132,16 @@ private:
 	bool PrepareCompressFrame(int flags, zmbv_format_t _format, char * pal);
 	int FinishCompressFrame(uint8_t** compressedData);
 
+	void DeflateThread();
+	int WaitForDeflate(uint8_t** compressedData);
+
 public:
 	ZmbvCodec();
+	virtual ~ZmbvCodec();
 	bool SetupCompress(int _width, int _height, uint32_t compressionLevel) override;
 	int CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t** compressedData) override;
 	const char* GetFourCC() override;
+
+	bool IsPipelined() override { return true; }
+	int FlushFrame(uint8_t** compressedData) override;
 };
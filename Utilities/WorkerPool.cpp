@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+	_threadCount = std::max<uint32_t>(1, threadCount);
+	_nextTask = 0;
+	_pendingTasks = 0;
+
+	for(uint32_t i = 1; i < _threadCount; i++) {
+		_threads.push_back(std::thread(&WorkerPool::WorkerThread, this));
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopFlag = true;
+	}
+	_startSignal.notify_all();
+
+	for(std::thread& thread : _threads) {
+		thread.join();
+	}
+}
+
+uint32_t WorkerPool::GetDefaultThreadCount()
+{
+	//Keep a core free for the emulation thread
+	uint32_t coreCount = std::thread::hardware_concurrency();
+	return std::clamp<uint32_t>(coreCount > 1 ? coreCount - 1 : 1, 1, 8);
+}
+
+void WorkerPool::Update(unique_ptr<WorkerPool>& pool, uint32_t threadCount)
+{
+	if(threadCount == 0) {
+		threadCount = GetDefaultThreadCount();
+	}
+
+	if(!pool || pool->GetThreadCount() != threadCount) {
+		pool.reset(new WorkerPool(threadCount));
+	}
+}
+
+void WorkerPool::ProcessTasks()
+{
+	uint32_t index;
+	while((index = _nextTask++) < _taskCount) {
+		_task(index);
+		_pendingTasks--;
+	}
+}
+
+void WorkerPool::WorkerThread()
+{
+	uint32_t lastJobId = 0;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startSignal.wait(lock, [&] { return _stopFlag || _jobId != lastJobId; });
+			if(_stopFlag) {
+				return;
+			}
+			lastJobId = _jobId;
+			_activeWorkers++;
+		}
+
+		ProcessTasks();
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_activeWorkers--;
+		}
+		_doneSignal.notify_all();
+	}
+}
+
+void WorkerPool::Run(uint32_t taskCount, std::function<void(uint32_t)> task)
+{
+	if(_threads.empty() || taskCount <= 1) {
+		for(uint32_t i = 0; i < taskCount; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		//A worker that woke up late for the previous job may still be looking at it
+		_doneSignal.wait(lock, [&] { return _activeWorkers == 0; });
+		_task = task;
+		_taskCount = taskCount;
+		_nextTask = 0;
+		_pendingTasks = taskCount;
+		_jobId++;
+	}
+	_startSignal.notify_all();
+
+	ProcessTasks();
+
+	//Wait until all tasks are done and no worker can still access the task (before the next job replaces it)
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneSignal.wait(lock, [&] { return _pendingTasks == 0 && _activeWorkers == 0; });
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "pch.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//Persistent set of worker threads used to split a single job (e.g a video filter) into multiple tasks
+//The calling thread also processes tasks, so a pool with a thread count of 1 runs everything on the calling thread
+class WorkerPool
+{
+private:
+	vector<std::thread> _threads;
+	uint32_t _threadCount = 1;
+
+	std::mutex _mutex;
+	std::condition_variable _startSignal;
+	std::condition_variable _doneSignal;
+
+	std::function<void(uint32_t)> _task;
+	uint32_t _taskCount = 0;
+	atomic<uint32_t> _nextTask;
+	atomic<uint32_t> _pendingTasks;
+	uint32_t _activeWorkers = 0;
+	uint32_t _jobId = 0;
+	bool _stopFlag = false;
+
+	void WorkerThread();
+	void ProcessTasks();
+
+public:
+	static constexpr uint32_t MinRowsPerBand = 16;
+
+	WorkerPool(uint32_t threadCount);
+	~WorkerPool();
+
+	uint32_t GetThreadCount() { return _threadCount; }
+
+	//Calls task(0) to task(taskCount - 1) on the pool's threads and returns once they have all completed
+	void Run(uint32_t taskCount, std::function<void(uint32_t)> task);
+
+	//Splits rows [0, rowCount) into one band per thread (each at least MinRowsPerBand rows)
+	//and calls processRows(firstRow, endRow) for each band in parallel
+	template<typename T>
+	void RunRowBands(uint32_t rowCount, T processRows)
+	{
+		uint32_t bandCount = std::clamp<uint32_t>(rowCount / MinRowsPerBand, 1, _threadCount);
+		uint32_t rowsPerBand = (rowCount + bandCount - 1) / bandCount;
+
+		Run(bandCount, [=](uint32_t band) {
+			uint32_t firstRow = band * rowsPerBand;
+			uint32_t endRow = std::min(firstRow + rowsPerBand, rowCount);
+			if(firstRow < endRow) {
+				processRows(firstRow, endRow);
+			}
+		});
+	}
+
+	//Returns the thread count to use when the user setting is 0 (auto)
+	static uint32_t GetDefaultThreadCount();
+
+	//(Re)creates the pool when it doesn't exist yet or when its thread count doesn't match the setting (0 = auto)
+	static void Update(unique_ptr<WorkerPool>& pool, uint32_t threadCount);
+};